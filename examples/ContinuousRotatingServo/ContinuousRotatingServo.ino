@@ -36,6 +36,7 @@
 //#define DEBUG                              // Activating this enables generate lots of lovely debug output for this library.
 
 //#define PRINT_FOR_SERIAL_PLOTTER           // Activating this enables generate the Arduino plotter output from ServoEasing.hpp.
+//#define ENABLE_VELOCITY_MODE               // Activating this uses setVelocity() for the speed ramps instead of position moves.
 
 #define MICROSECONDS_FOR_ROTATING_SERVO_STOP 1500 // Change this value to your servos real stop value
 #include "ServoEasing.hpp"
@@ -109,6 +110,26 @@ void blinkLED() {
 }
 
 void loop() {
+#if defined(ENABLE_VELOCITY_MODE)
+    /*
+     * Now ramp the speed up and down, the ramp is computed by the servo interrupt
+     */
+    Serial.println(F("Ramp clockwise to maximum speed and back to stop with 50 per second"));
+    Servo1.setVelocity(100, 50);
+    delay(3000);
+    Servo1.setVelocity(0, 50);
+    delay(3000);
+
+    Serial.println(F("Ramp counter clockwise to half speed and back to stop with 20 per second"));
+    Servo1.setVelocity(-50, 20);
+    delay(3000);
+    Servo1.setVelocity(0, 20);
+    while (Servo1.getCurrentAngle() != 0) {
+        blinkLED();
+    }
+    Servo1.disableVelocityMode();
+    delay(1000);
+#else
     /*
      * Now move a speed ramp up and down
      */
@@ -132,4 +153,5 @@ void loop() {
         blinkLED();
     }
     delay(1000);
+#endif
 }
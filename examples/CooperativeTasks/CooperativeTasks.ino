@@ -0,0 +1,158 @@
+/*
+ * CooperativeTasks.cpp
+ *
+ *  Runs two independent servo sequences and a potentiometer read concurrently without blocking.
+ *  Each sequence is written linearly as a ServoEasing task, which yields at every wait instead of calling delay().
+ *  The servos are updated by runServoEasingTasks() in loop(), so this example does not require interrupts.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#include <Arduino.h>
+
+// Must specify this before the include of "ServoEasing.hpp"
+//#define USE_PCA9685_SERVO_EXPANDER    // Activating this enables the use of the PCA9685 I2C expander chip/board.
+//#define USE_SERVO_LIB                 // If USE_PCA9685_SERVO_EXPANDER is defined, Activating this enables force additional using of regular servo library.
+//#define PROVIDE_ONLY_LINEAR_MOVEMENT  // Activating this disables all but LINEAR movement. Saves up to 1540 bytes program memory.
+#define DISABLE_COMPLEX_FUNCTIONS     // Activating this disables the SINE, CIRCULAR, BACK, ELASTIC, BOUNCE and PRECISION easings. Saves up to 1850 bytes program memory.
+#define MAX_EASING_SERVOS 3
+#define ENABLE_SERVO_EASING_TASKS
+//#define DEBUG                              // Activating this enables generate lots of lovely debug output for this library.
+
+#include "ServoEasing.hpp"
+#include "PinDefinitionsAndMore.h"
+
+/*
+ * Pin mapping table for different platforms - used by all examples
+ *
+ * Platform         Servo1      Servo2      Servo3      Analog     Core/Pin schema
+ * -------------------------------------------------------------------------------
+ * (Mega)AVR + SAMD    9          10          11          A0
+ * ATtiny3217         20|PA3       0|PA4       1|PA5       2|PA6   MegaTinyCore
+ * ESP8266            14|D5       12|D6       13|D7        0
+ * ESP32               5          18          19          A0
+ * BluePill          PB7         PB8         PB9         PA0
+ * APOLLO3            11          12          13          A3
+ * RP2040             6|GPIO18     7|GPIO19    8|GPIO20
+ */
+
+ServoEasing Servo1;
+ServoEasing Servo2;
+ServoEasing Servo3;
+
+#define START_DEGREE_VALUE  90 // The degree value written to the servo at time of attach.
+
+uint_fast16_t sServo1Speed = 60; // Is set by readSpeedTask()
+
+ServoEasingTask SweepTask;
+ServoEasingTask NodTask;
+ServoEasingTask ReadSpeedTask;
+
+/*
+ * Sweep servo 1 from 0 to 180 degree and back with the speed read from the potentiometer
+ */
+bool sweepTask(ServoEasingTask *aTask) {
+    SERVO_EASING_TASK_BEGIN(aTask);
+    Servo1.startEaseTo(0, sServo1Speed, DO_NOT_START_UPDATE_BY_INTERRUPT);
+    SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, Servo1);
+    SERVO_EASING_TASK_DELAY(aTask, 500);
+    Servo1.startEaseTo(180, sServo1Speed, DO_NOT_START_UPDATE_BY_INTERRUPT);
+    SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, Servo1);
+    SERVO_EASING_TASK_DELAY(aTask, 500);
+    SERVO_EASING_TASK_END(aTask); // and is restarted by loop()
+}
+
+/*
+ * Nod 3 times with servo 2 and 3 synchronized, then pause 2 seconds
+ */
+bool nodTask(ServoEasingTask *aTask) {
+    static uint8_t sNodCount; // local variables are not preserved across waits
+    SERVO_EASING_TASK_BEGIN(aTask);
+    for (sNodCount = 0; sNodCount < 3; ++sNodCount) {
+        // Synchronize by simply using the same duration
+        Servo2.startEaseToD(45, 600, DO_NOT_START_UPDATE_BY_INTERRUPT);
+        Servo3.startEaseToD(135, 600, DO_NOT_START_UPDATE_BY_INTERRUPT);
+        SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, Servo2);
+        Servo2.startEaseToD(135, 600, DO_NOT_START_UPDATE_BY_INTERRUPT);
+        Servo3.startEaseToD(45, 600, DO_NOT_START_UPDATE_BY_INTERRUPT);
+        SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, Servo2);
+    }
+    Servo2.startEaseToD(90, 300, DO_NOT_START_UPDATE_BY_INTERRUPT);
+    Servo3.startEaseToD(90, 300, DO_NOT_START_UPDATE_BY_INTERRUPT);
+    SERVO_EASING_TASK_DELAY(aTask, 2000);
+    SERVO_EASING_TASK_END(aTask);
+}
+
+/*
+ * Read the potentiometer every 100 ms and toggle the LED every second, to show that we are not blocked
+ */
+bool readSpeedTask(ServoEasingTask *aTask) {
+    static uint8_t sReadCount;
+    SERVO_EASING_TASK_BEGIN(aTask);
+    while (true) {
+        sServo1Speed = map(analogRead(SPEED_IN_PIN), 0, 1023, 10, 200);
+        if (++sReadCount >= 10) {
+            sReadCount = 0;
+            digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+        }
+        SERVO_EASING_TASK_DELAY(aTask, 100);
+    }
+    SERVO_EASING_TASK_END(aTask);
+}
+
+void setup() {
+    pinMode(LED_BUILTIN, OUTPUT);
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/|| defined(SERIALUSB_PID) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_SERVO_EASING));
+
+    Serial.println(F("Attach servos at pin " STR(SERVO1_PIN) ", " STR(SERVO2_PIN) " and " STR(SERVO3_PIN)));
+    Servo1.attach(SERVO1_PIN, START_DEGREE_VALUE);
+    Servo2.attach(SERVO2_PIN, START_DEGREE_VALUE);
+    if (Servo3.attach(SERVO3_PIN, START_DEGREE_VALUE) == INVALID_SERVO) {
+        Serial.println(F("Error attaching servo"));
+    }
+    Servo1.setEasingType(EASE_CUBIC_IN_OUT);
+    Servo2.setEasingType(EASE_QUADRATIC_IN_OUT);
+    Servo3.setEasingType(EASE_QUADRATIC_IN_OUT);
+
+    // Just wait for servos to reach position.
+    delay(500);
+
+    startServoEasingTask(&ReadSpeedTask, &readSpeedTask);
+    startServoEasingTask(&SweepTask, &sweepTask);
+    startServoEasingTask(&NodTask, &nodTask);
+}
+
+void loop() {
+    runServoEasingTasks();
+
+    /*
+     * Restart the sequences if they have finished
+     */
+    if (!isServoEasingTaskRunning(&SweepTask)) {
+        startServoEasingTask(&SweepTask, &sweepTask);
+    }
+    if (!isServoEasingTaskRunning(&NodTask)) {
+        startServoEasingTask(&NodTask, &nodTask);
+    }
+}
@@ -448,6 +448,124 @@ float getTemperature(void) {
 #endif
 }
 
+#if defined(ENABLE_ADC_BACKGROUND_SAMPLING)
+struct ADCBackgroundChannelStruct {
+    uint8_t ADMUXValue;
+    uint8_t OversampleExponent;
+};
+ADCBackgroundChannelStruct sADCBackgroundChannels[ADC_BACKGROUND_MAX_CHANNELS];
+volatile uint16_t sADCBackgroundValues[ADC_BACKGROUND_MAX_CHANNELS]; // Only the finished averages are written here
+uint8_t sADCBackgroundNumberOfChannels;
+uint8_t sADCBackgroundChannelIndex;
+uint16_t sADCBackgroundSum; // The average of the current channel is accumulated here
+uint8_t sADCBackgroundSampleCount;
+uint8_t sADCBackgroundSamplesToDiscard;
+volatile uint16_t sADCBackgroundNumberOfRounds;
+
+/*
+ * @param aOversampleExponent 0 to ADC_BACKGROUND_MAX_OVERSAMPLE_EXPONENT
+ * @return Index for getADCBackgroundValue() or ADC_BACKGROUND_MAX_CHANNELS if all channels are in use
+ */
+uint8_t addADCBackgroundChannel(uint8_t aChannelNumber, uint8_t aReference, uint8_t aOversampleExponent) {
+    uint8_t tIndex = sADCBackgroundNumberOfChannels;
+    if (tIndex < ADC_BACKGROUND_MAX_CHANNELS) {
+        if (aOversampleExponent > ADC_BACKGROUND_MAX_OVERSAMPLE_EXPONENT) {
+            aOversampleExponent = ADC_BACKGROUND_MAX_OVERSAMPLE_EXPONENT;
+        }
+        sADCBackgroundChannels[tIndex].ADMUXValue = aChannelNumber | (aReference << SHIFT_VALUE_FOR_REFERENCE);
+        sADCBackgroundChannels[tIndex].OversampleExponent = aOversampleExponent;
+        sADCBackgroundNumberOfChannels = tIndex + 1;
+    }
+    return tIndex;
+}
+
+/*
+ * Set multiplexer for the channel and compute the number of samples to discard, like checkAndWaitForReferenceAndChannelToSwitch() does.
+ * One sample takes 0.104 ms.
+ */
+void setADCBackgroundChannel(uint8_t aIndex) {
+    uint8_t tOldADMUX = ADMUX;
+    uint8_t tNewADMUX = sADCBackgroundChannels[aIndex].ADMUXValue;
+    ADMUX = tNewADMUX;
+    if ((tOldADMUX & MASK_FOR_ADC_REFERENCE) != (tNewADMUX & MASK_FOR_ADC_REFERENCE)) {
+        sADCBackgroundSamplesToDiscard = 80; // switch to INTERNAL requires >= 7600 us
+    } else if ((tOldADMUX & MASK_FOR_ADC_CHANNELS) != (tNewADMUX & MASK_FOR_ADC_CHANNELS)) {
+        if ((tNewADMUX & MASK_FOR_ADC_CHANNELS) == (ADC_1_1_VOLT_CHANNEL_MUX & MASK_FOR_ADC_CHANNELS)) {
+            sADCBackgroundSamplesToDiscard = 4; // internal 1.1 volt channel requires 350 us
+        } else {
+            sADCBackgroundSamplesToDiscard = 2; // 1 MOhm requires 120 us
+        }
+    }
+}
+
+/*
+ * Starts the first conversion. The following conversions are started by the ADC interrupt.
+ */
+void startADCBackgroundSampling() {
+    if (sADCBackgroundNumberOfChannels > 0) {
+        sADCBackgroundChannelIndex = 0;
+        sADCBackgroundSum = 0;
+        sADCBackgroundSampleCount = 0;
+        sADCBackgroundSamplesToDiscard = 1;
+        setADCBackgroundChannel(0);
+        ADCSRB = 0;
+        // ADSC-StartConversion ADIE-InterruptEnable ADIF-Reset Interrupt Flag
+        ADCSRA = (_BV(ADEN) | _BV(ADSC) | _BV(ADIE) | _BV(ADIF) | ADC_PRESCALE);
+    }
+}
+
+/*
+ * A running conversion is finished without interrupt
+ */
+void stopADCBackgroundSampling() {
+    ADCSRA &= ~_BV(ADIE);
+}
+
+uint16_t getADCBackgroundValue(uint8_t aIndex) {
+    uint8_t tSREG = SREG;
+    cli(); // 16 bit value is written by the ADC interrupt
+    uint16_t tValue = sADCBackgroundValues[aIndex];
+    SREG = tSREG;
+    return tValue;
+}
+
+/*
+ * Is incremented each time, the values of all channels are renewed. Can be used to detect a new set of values.
+ */
+uint16_t getADCBackgroundNumberOfRounds() {
+    uint8_t tSREG = SREG;
+    cli();
+    uint16_t tNumberOfRounds = sADCBackgroundNumberOfRounds;
+    SREG = tSREG;
+    return tNumberOfRounds;
+}
+
+ISR(ADC_vect) {
+    uint16_t tValue = ADCL | (ADCH << 8);
+    if (sADCBackgroundSamplesToDiscard > 0) {
+        sADCBackgroundSamplesToDiscard--;
+    } else {
+        sADCBackgroundSum += tValue;
+        sADCBackgroundSampleCount++;
+        uint8_t tOversampleExponent = sADCBackgroundChannels[sADCBackgroundChannelIndex].OversampleExponent;
+        if (sADCBackgroundSampleCount >= _BV(tOversampleExponent)) {
+            // return rounded value
+            sADCBackgroundValues[sADCBackgroundChannelIndex] = (sADCBackgroundSum + (sADCBackgroundSampleCount >> 1))
+                    >> tOversampleExponent;
+            sADCBackgroundSum = 0;
+            sADCBackgroundSampleCount = 0;
+            sADCBackgroundChannelIndex++;
+            if (sADCBackgroundChannelIndex >= sADCBackgroundNumberOfChannels) {
+                sADCBackgroundChannelIndex = 0;
+                sADCBackgroundNumberOfRounds++;
+            }
+            setADCBackgroundChannel(sADCBackgroundChannelIndex);
+        }
+    }
+    ADCSRA |= _BV(ADSC); // start next conversion
+}
+#endif // defined(ENABLE_ADC_BACKGROUND_SAMPLING)
+
 #elif defined(ARDUINO_ARCH_APOLLO3) // defined(__AVR__) && defined(ADATE)
     void ADCUtilsDummyToAvoidBFDAssertions(){
         ;
@@ -46,6 +46,8 @@
 //#define DISABLE_MICROS_AS_DEGREE_PARAMETER // Activating this disables microsecond values as (target angle) parameter. Saves 128 bytes program memory.
 //#define DISABLE_MIN_AND_MAX_CONSTRAINTS    // Activating this disables constraints. Saves 4 bytes RAM per servo but strangely enough no program memory.
 //#define DISABLE_PAUSE_RESUME               // Activating this disables pause and resume functions. Saves 5 bytes RAM per servo.
+//#define ENABLE_COMPACT_SERVO_LAYOUT        // Activating this enables 16 bit time stamps, packed flags and int16_t next positions. Saves 7 bytes RAM per servo.
+//#define DISABLE_TARGET_POSITION_REACHED_HANDLER // Activating this disables the callback at end of move. Saves 2 bytes RAM per servo.
 //#define DEBUG                              // Activating this enables generate lots of lovely debug output for this library.
 
 //#define PRINT_FOR_SERIAL_PLOTTER           // Activating this enables generate the Arduino plotter output from ServoEasing.hpp.
@@ -0,0 +1,244 @@
+/*
+ * PCA9685_StressBenchmark.cpp
+ *
+ * Stress test for large installations with up to 8 PCA9685 expander boards, i.e. 128 servos.
+ * All servos move concurrently with random targets, speeds and easing types, driven by the ServoEasing interrupt.
+ * Every REPORT_INTERVAL_MILLIS the update statistics are printed, i.e. the frame time, the number of frames
+ * which took longer than UPDATE_BUDGET_MICROS (overruns), servo writes and I2C bytes per frame, the free RAM
+ * and the achieved update rate per servo.
+ *
+ * Compile it once with and once without ENABLE_PCA9685_FRAME_COMMIT to compare one I2C transmission per servo write
+ * with one transmission per run of changed channels sent at the end of each frame.
+ * Increase NUMBER_OF_PCA9685_EXPANDERS until the overruns show the scaling limit of your board and I2C bus.
+ *
+ * Missing boards are skipped, so it can also run with less boards than specified.
+ * The boards must have consecutive addresses starting at PCA9685_DEFAULT_ADDRESS (0x40). The ALLCALL address 0x70 is skipped.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#include <Arduino.h>
+
+#if !defined(NUMBER_OF_PCA9685_EXPANDERS)
+#  if defined(__AVR__) && (RAMEND <= 0x8FF)
+#define NUMBER_OF_PCA9685_EXPANDERS 2 // 2 kByte RAM is not sufficient for more servo objects
+#  elif defined(__AVR__)
+#define NUMBER_OF_PCA9685_EXPANDERS 4
+#  else
+#define NUMBER_OF_PCA9685_EXPANDERS 8
+#  endif
+#endif
+
+// Must specify this before the include of "ServoEasing.hpp"
+#define USE_PCA9685_SERVO_EXPANDER    // Activating this enables the use of the PCA9685 I2C expander chip/board.
+//#define USE_SOFT_I2C_MASTER           // Saves 1756 bytes program memory and 218 bytes RAM compared with Arduino Wire
+//#define ENABLE_PCA9685_FRAME_COMMIT   // Send all PCA9685 channels changed by updateAllServos() with one I2C transmission per run of changed channels.
+//#define ENABLE_ACTIVE_SERVO_LIST      // Only the moving servos are updated.
+//#define PROVIDE_ONLY_LINEAR_MOVEMENT  // Activating this disables all but LINEAR movement. Saves up to 1540 bytes program memory.
+//#define DISABLE_COMPLEX_FUNCTIONS     // Activating this disables the SINE, CIRCULAR, BACK, ELASTIC, BOUNCE and PRECISION easings. Saves up to 1850 bytes program memory.
+//#define ENABLE_COMPACT_SERVO_LAYOUT   // Activating this enables 16 bit time stamps, packed flags and int16_t next positions. Saves 7 bytes RAM per servo.
+#define MAX_EASING_SERVOS           (NUMBER_OF_PCA9685_EXPANDERS * PCA9685_MAX_CHANNELS)
+#define MAX_PCA9685_EXPANDERS       NUMBER_OF_PCA9685_EXPANDERS
+#define ENABLE_UPDATE_STATISTICS
+#include "ServoEasing.hpp"
+#include "PinDefinitionsAndMore.h"
+
+// for ESP32 LED_BUILTIN is defined as static const uint8_t LED_BUILTIN = 2;
+#if !defined(LED_BUILTIN) && !defined(ESP32)
+#define LED_BUILTIN PB1
+#endif
+
+#define REPORT_INTERVAL_MILLIS  5000
+#define MINIMUM_SPEED           20  // degree per second
+#define MAXIMUM_SPEED           200
+
+uint8_t getAndAttachServosToPCA9685Expanders(uint8_t aFirstPCA9685I2CAddress, uint8_t aNumberOfExpanders);
+void startRandomMoves();
+void printReport(uint32_t aMillisSinceLastReport);
+int getFreeRam();
+
+uint32_t sMillisOfLastReport;
+uint8_t sNumberOfExpanders;
+
+void setup() {
+    pinMode(LED_BUILTIN, OUTPUT);
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/|| defined(SERIALUSB_PID) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_SERVO_EASING));
+#if defined(ENABLE_PCA9685_FRAME_COMMIT)
+    Serial.println(F("Servo writes are sent with one transmission per run of changed channels at the end of each frame"));
+#else
+    Serial.println(F("Each servo write is sent with its own I2C transmission"));
+#endif
+
+    // Initialize wire before checkI2CConnection()
+    Wire.begin();  // Starts with 100 kHz. Clock will be increased at first attach() except for ESP32.
+#if defined (ARDUINO_ARCH_AVR) // Other platforms do not have this new function
+    Wire.setWireTimeout(); // Sets default timeout of 25 ms.
+#endif
+    sNumberOfExpanders = getAndAttachServosToPCA9685Expanders(PCA9685_DEFAULT_ADDRESS, NUMBER_OF_PCA9685_EXPANDERS);
+    Serial.print(sNumberOfExpanders);
+    Serial.print(F(" expanders with "));
+    Serial.print(ServoEasing::sServoArrayMaxIndex + 1);
+    Serial.println(F(" servos attached"));
+    if (sNumberOfExpanders == 0) {
+        while (true) {
+            digitalWrite(LED_BUILTIN, HIGH);
+            delay(100);
+            digitalWrite(LED_BUILTIN, LOW);
+            delay(100);
+        }
+    }
+
+    writeAllServos(90);
+    delay(500);
+
+    // Columns of the report lines
+    Serial.println(F("Expanders;Servos;Moving;Frame us avg;Frame us max;Overruns;Frames;Writes per frame max;I2C bytes per frame max;"
+            "Updates per servo and second;Free RAM"));
+    resetUpdateStatistics();
+    sMillisOfLastReport = millis();
+}
+
+void loop() {
+    startRandomMoves();
+
+    uint32_t tMillisSinceLastReport = millis() - sMillisOfLastReport;
+    if (tMillisSinceLastReport >= REPORT_INTERVAL_MILLIS) {
+        sMillisOfLastReport = millis();
+        printReport(tMillisSinceLastReport);
+        resetUpdateStatistics();
+    }
+}
+
+/*
+ * Start a new move for each servo which has reached its target, so all servos move concurrently
+ */
+void startRandomMoves() {
+    for (uint_fast8_t tServoIndex = 0; tServoIndex <= ServoEasing::sServoArrayMaxIndex; ++tServoIndex) {
+        ServoEasing *tServo = ServoEasing::ServoEasingArray[tServoIndex];
+        if (tServo != NULL && !tServo->isMoving()) {
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+            tServo->setEasingType(random(2) == 0 ? EASE_LINEAR : EASE_CUBIC_IN_OUT);
+#endif
+            tServo->startEaseTo((int) random(181), (uint_fast16_t) random(MINIMUM_SPEED, MAXIMUM_SPEED + 1), START_UPDATE_BY_INTERRUPT);
+        }
+    }
+}
+
+/*
+ * Prints one line with semicolon separated values
+ */
+void printReport(uint32_t aMillisSinceLastReport) {
+    // copy the statistics, since they are changed by the interrupt
+    noInterrupts();
+    ServoEasingUpdateStatisticsStruct tStatistics = ServoEasing::sUpdateStatistics;
+    interrupts();
+
+    uint_fast8_t tNumberOfMovingServos = 0;
+    for (uint_fast8_t tServoIndex = 0; tServoIndex <= ServoEasing::sServoArrayMaxIndex; ++tServoIndex) {
+        if (ServoEasing::ServoEasingArray[tServoIndex] != NULL && ServoEasing::ServoEasingArray[tServoIndex]->isMoving()) {
+            tNumberOfMovingServos++;
+        }
+    }
+
+    Serial.print(sNumberOfExpanders);
+    Serial.print(';');
+    Serial.print(ServoEasing::sServoArrayMaxIndex + 1);
+    Serial.print(';');
+    Serial.print(tNumberOfMovingServos);
+    Serial.print(';');
+    if (tStatistics.NumberOfUpdates != 0) {
+        Serial.print(tStatistics.SumOfUpdateMicros / tStatistics.NumberOfUpdates);
+    }
+    Serial.print(';');
+    Serial.print(tStatistics.MaxUpdateMicros);
+    Serial.print(';');
+    Serial.print(tStatistics.NumberOfOverBudgetUpdates);
+    Serial.print(';');
+    Serial.print(tStatistics.NumberOfUpdates);
+    Serial.print(';');
+    Serial.print(tStatistics.MaxNumberOfServoWrites);
+    Serial.print(';');
+    Serial.print(tStatistics.MaxNumberOfI2CBytes);
+    Serial.print(';');
+    /*
+     * Each frame updates each moving servo once, so the frame rate is the update rate of each servo.
+     * It is less than 1000 / REFRESH_INTERVAL_MILLIS, if frames take longer than the refresh interval.
+     */
+    Serial.print((tStatistics.NumberOfUpdates * 1000.0) / aMillisSinceLastReport, 1);
+    Serial.print(';');
+    Serial.print(getFreeRam());
+    Serial.println();
+}
+
+/*
+ * Generalized version of getAndAttach16ServosToPCA9685Expander() of the PCA9685_ExpanderFor32Servos example.
+ * Get the 16 ServoEasing objects for each connected PCA9685 expander.
+ * The attach() function inserts them in the ServoEasing::ServoEasingArray[] array.
+ * @return Number of connected expanders
+ */
+uint8_t getAndAttachServosToPCA9685Expanders(uint8_t aFirstPCA9685I2CAddress, uint8_t aNumberOfExpanders) {
+    uint8_t tNumberOfConnectedExpanders = 0;
+    uint8_t tPCA9685I2CAddress = aFirstPCA9685I2CAddress;
+    for (uint_fast8_t tExpanderIndex = 0; tExpanderIndex < aNumberOfExpanders; ++tExpanderIndex) {
+        if (tPCA9685I2CAddress == PCA9685_ALLCALL_ADDRESS) {
+            tPCA9685I2CAddress++; // All boards respond to this address
+        }
+        if (checkI2CConnection(tPCA9685I2CAddress, &Serial)) {
+            tPCA9685I2CAddress++;
+            continue; // Board not connected
+        }
+        tNumberOfConnectedExpanders++;
+        for (uint_fast8_t tChannel = 0; tChannel < PCA9685_MAX_CHANNELS; ++tChannel) {
+            ServoEasing *tServoEasingObjectPtr = new ServoEasing(tPCA9685I2CAddress);
+            if (tServoEasingObjectPtr->attach(tChannel) == INVALID_SERVO) {
+                Serial.print(F("Address=0x"));
+                Serial.print(tPCA9685I2CAddress, HEX);
+                Serial.print(F(" channel="));
+                Serial.print(tChannel);
+                Serial.println(F(" Error attaching servo - maybe MAX_EASING_SERVOS=" STR(MAX_EASING_SERVOS) " is to small"));
+            }
+        }
+        tPCA9685I2CAddress++;
+    }
+    return tNumberOfConnectedExpanders;
+}
+
+/*
+ * Get amount of free RAM = Stack - Heap
+ * @return -1 if not available for this platform
+ */
+int getFreeRam() {
+#if defined(__AVR__)
+    extern unsigned int __heap_start;
+    extern void *__brkval;
+    if (__brkval == 0) {
+        return SP - (int) &__heap_start;
+    }
+    return SP - (int) __brkval;
+#elif defined(ESP8266) || defined(ESP32)
+    return ESP.getFreeHeap();
+#else
+    return -1;
+#endif
+}
@@ -38,6 +38,21 @@
 #define IR_COMMAND_FLAG_REPEATABLE      0x01 // repeat accepted
 #define IR_COMMAND_FLAG_NON_BLOCKING    0x02 // Non blocking (short) command that can be processed any time and may interrupt other IR commands - used for stop, set direction etc.
 #define IR_COMMAND_FLAG_REPEATABLE_NON_BLOCKING (IR_COMMAND_FLAG_REPEATABLE | IR_COMMAND_FLAG_NON_BLOCKING)
+#define IR_COMMAND_FLAG_STOP            0x04 // Stop / emergency command. Only evaluated for ENABLE_IR_COMMAND_QUEUE.
+
+/*
+ * If ENABLE_IR_COMMAND_QUEUE is defined, blocking commands received while another blocking command is running
+ * are stored in a queue of IR_COMMAND_QUEUE_SIZE entries, instead of in one variable, which is overwritten by the next command.
+ * So commands are no longer lost during long moves. Repeats of the last queued command are not queued again.
+ * A command flagged with IR_COMMAND_FLAG_STOP and a command set by setNextBlockingCommand() have high priority
+ * and are run before all queued commands. A stop command additionally discards all queued commands
+ * and calls the stop handler set by setStopHandler() directly in ISR context, e.g. stopAllServos() of ServoEasing.
+ * This ends all running moves immediately, so a blocking command waiting for the end of a move returns without polling.
+ */
+//#define ENABLE_IR_COMMAND_QUEUE
+#if defined(ENABLE_IR_COMMAND_QUEUE) && !defined(IR_COMMAND_QUEUE_SIZE)
+#define IR_COMMAND_QUEUE_SIZE   4 // Must be a power of 2
+#endif
 
 // Basic mapping structure
 struct IRToCommandMappingStruct {
@@ -94,6 +109,17 @@ public:
 
     void printIRCommandString(Print *aSerial);
     void setRequestToStopReceived(bool aRequestToStopReceived = true);
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+    void setStopHandler(void (*aStopHandler)());
+#  if defined(IR_COMMAND_HAS_MORE_THAN_8_BIT)
+    void storeBlockingCommand(uint16_t aBlockingCommand, bool aIsStopCommand);
+    uint16_t takeNextBlockingCommand();
+#  else
+    void storeBlockingCommand(uint8_t aBlockingCommand, bool aIsStopCommand);
+    uint8_t takeNextBlockingCommand();
+#  endif
+    void discardQueuedBlockingCommands();
+#endif
 
 #if defined(IR_COMMAND_HAS_MORE_THAN_8_BIT)
     uint16_t currentBlockingCommandCalled = COMMAND_EMPTY; // The code for the current called command
@@ -103,6 +129,22 @@ public:
     uint8_t currentBlockingCommandCalled = COMMAND_EMPTY; // The code for the current called command
     uint8_t lastBlockingCommandCalled = COMMAND_EMPTY;  // The code for the last called command. Can be evaluated by main loop
     uint8_t BlockingCommandToRunNext = COMMAND_EMPTY;   // Storage for command currently suspended to allow the current command to end, before it is called by main loop
+#endif
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+    /*
+     * Written by the IR callback and the non blocking commands called by it, read by main loop with interrupts disabled
+     */
+#  if defined(IR_COMMAND_HAS_MORE_THAN_8_BIT)
+    volatile uint16_t HighPriorityBlockingCommand = COMMAND_EMPTY; // Stop command or command set by setNextBlockingCommand()
+    uint16_t BlockingCommandQueue[IR_COMMAND_QUEUE_SIZE];
+#  else
+    volatile uint8_t HighPriorityBlockingCommand = COMMAND_EMPTY; // Stop command or command set by setNextBlockingCommand()
+    uint8_t BlockingCommandQueue[IR_COMMAND_QUEUE_SIZE];
+#  endif
+    volatile uint8_t BlockingCommandQueueReadIndex = 0;
+    volatile uint8_t BlockingCommandQueueWriteIndex = 0;
+    uint8_t NumberOfLostBlockingCommands = 0; // Commands discarded since the queue was full
+    void (*StopHandler)() = NULL; // Called in ISR context if a command flagged with IR_COMMAND_FLAG_STOP is received
 #endif
     bool justCalledBlockingCommand = false;             // Flag that a blocking command was received and called - is set before call of command
     /*
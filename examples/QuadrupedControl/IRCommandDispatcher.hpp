@@ -10,6 +10,7 @@
  * The IR library calls a callback function, which executes a non blocking command directly in ISR context!
  * A blocking command is stored and sets a stop flag for an already running blocking function to terminate.
  * The blocking command can in turn be executed by main loop by calling IRDispatcher.checkAndRunSuspendedBlockingCommands().
+ * With ENABLE_IR_COMMAND_QUEUE, blocking commands are queued and stop commands preempt running commands by calling the stop handler.
  *
  *  Copyright (C) 2019-2021  Armin Joachimsmeyer
  *  armin.joachimsmeyer@gmail.com
@@ -214,6 +215,15 @@ void IRCommandDispatcher::checkAndCallCommand(bool aCallBlockingCommandImmediate
 
             bool tIsNonBlockingCommand = (IRMapping[i].Flags & IR_COMMAND_FLAG_NON_BLOCKING);
             if (tIsNonBlockingCommand) {
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+                if (IRMapping[i].Flags & IR_COMMAND_FLAG_STOP) {
+                    discardQueuedBlockingCommands();
+                    requestToStopReceived = true; // to stop running command
+                    if (StopHandler != NULL) {
+                        StopHandler();
+                    }
+                }
+#endif
                 // short command here, just call
                 CD_INFO_PRINT(F("Run non blocking command: "));
                 CD_INFO_PRINTLN (tCommandName);
@@ -241,7 +251,11 @@ void IRCommandDispatcher::checkAndCallCommand(bool aCallBlockingCommandImmediate
                     /*
                      * Do not run command directly, but set request to stop to true and store command for main loop to execute
                      */
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+                    storeBlockingCommand(IRReceivedData.command, IRMapping[i].Flags & IR_COMMAND_FLAG_STOP);
+#else
                     BlockingCommandToRunNext = IRReceivedData.command;
+#endif
                     requestToStopReceived = true; // to stop running command
                     CD_INFO_PRINT(F("Requested stop and stored blocking command "));
                     CD_INFO_PRINT (tCommandName);
@@ -259,6 +273,26 @@ void IRCommandDispatcher::checkAndCallCommand(bool aCallBlockingCommandImmediate
  * @return true, if command was called
  */
 bool IRCommandDispatcher::checkAndRunSuspendedBlockingCommands() {
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+    /*
+     * Take highest priority command and call associated function
+     */
+#  if defined(IR_COMMAND_HAS_MORE_THAN_8_BIT)
+    uint16_t tCommand = takeNextBlockingCommand();
+#  else
+    uint8_t tCommand = takeNextBlockingCommand();
+#  endif
+    if (tCommand != COMMAND_EMPTY) {
+
+        CD_INFO_PRINT(F("Take queued command = 0x"));
+        CD_INFO_PRINTLN(tCommand, HEX);
+
+        IRReceivedData.command = tCommand;
+        IRReceivedData.isRepeat = false;
+        checkAndCallCommand(true);
+        return true;
+    }
+#else
     /*
      * Take last rejected command and call associated function
      */
@@ -273,6 +307,7 @@ bool IRCommandDispatcher::checkAndRunSuspendedBlockingCommands() {
         checkAndCallCommand(true);
         return true;
     }
+#endif
     return false;
 }
 
@@ -284,10 +319,84 @@ void IRCommandDispatcher::setNextBlockingCommand(uint8_t aBlockingCommandToRunNe
         {
     CD_INFO_PRINT(F("Set next command to 0x"));
     CD_INFO_PRINTLN(aBlockingCommandToRunNext, HEX);
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+    HighPriorityBlockingCommand = aBlockingCommandToRunNext;
+#else
     BlockingCommandToRunNext = aBlockingCommandToRunNext;
+#endif
     requestToStopReceived = true;
 }
 
+#if defined(ENABLE_IR_COMMAND_QUEUE)
+void IRCommandDispatcher::setStopHandler(void (*aStopHandler)()) {
+    StopHandler = aStopHandler;
+}
+
+/*
+ * Called by the IR callback, i.e. in ISR context
+ * A stop command discards all queued commands, is stored with high priority and calls the stop handler.
+ * Other commands are appended to the queue, if they are not equal to the last queued command, e.g. a repeat.
+ */
+#  if defined(IR_COMMAND_HAS_MORE_THAN_8_BIT)
+void IRCommandDispatcher::storeBlockingCommand(uint16_t aBlockingCommand, bool aIsStopCommand)
+#  else
+void IRCommandDispatcher::storeBlockingCommand(uint8_t aBlockingCommand, bool aIsStopCommand)
+#  endif
+        {
+    if (aIsStopCommand) {
+        discardQueuedBlockingCommands();
+        HighPriorityBlockingCommand = aBlockingCommand;
+        if (StopHandler != NULL) {
+            StopHandler();
+        }
+        return;
+    }
+    uint8_t tWriteIndex = BlockingCommandQueueWriteIndex;
+    if (tWriteIndex != BlockingCommandQueueReadIndex
+            && BlockingCommandQueue[(tWriteIndex - 1) & (IR_COMMAND_QUEUE_SIZE - 1)] == aBlockingCommand) {
+        return; // already queued as last command
+    }
+    uint8_t tNextWriteIndex = (tWriteIndex + 1) & (IR_COMMAND_QUEUE_SIZE - 1);
+    if (tNextWriteIndex == BlockingCommandQueueReadIndex) {
+        NumberOfLostBlockingCommands++;
+        CD_INFO_PRINTLN(F("Command queue full"));
+        return;
+    }
+    BlockingCommandQueue[tWriteIndex] = aBlockingCommand;
+    BlockingCommandQueueWriteIndex = tNextWriteIndex;
+}
+
+/*
+ * Intended to be called from main loop
+ * @return The high priority command or the oldest queued command or COMMAND_EMPTY
+ */
+#  if defined(IR_COMMAND_HAS_MORE_THAN_8_BIT)
+uint16_t IRCommandDispatcher::takeNextBlockingCommand() {
+    uint16_t tCommand = COMMAND_EMPTY;
+#  else
+uint8_t IRCommandDispatcher::takeNextBlockingCommand() {
+    uint8_t tCommand = COMMAND_EMPTY;
+#  endif
+    noInterrupts(); // the IR callback may store a new command in between
+    if (HighPriorityBlockingCommand != COMMAND_EMPTY) {
+        tCommand = HighPriorityBlockingCommand;
+        HighPriorityBlockingCommand = COMMAND_EMPTY;
+    } else if (BlockingCommandQueueReadIndex != BlockingCommandQueueWriteIndex) {
+        tCommand = BlockingCommandQueue[BlockingCommandQueueReadIndex];
+        BlockingCommandQueueReadIndex = (BlockingCommandQueueReadIndex + 1) & (IR_COMMAND_QUEUE_SIZE - 1);
+    }
+    interrupts();
+    return tCommand;
+}
+
+/*
+ * Called in ISR context by stop commands
+ */
+void IRCommandDispatcher::discardQueuedBlockingCommands() {
+    BlockingCommandQueueReadIndex = BlockingCommandQueueWriteIndex;
+}
+#endif
+
 /*
  * Special delay function for the IRCommandDispatcher. Returns prematurely if requestToStopReceived is set.
  * To be used in blocking functions as delay
@@ -63,12 +63,14 @@
 #endif
 
 //#define USE_USER_DEFINED_MOVEMENTS
+//#define QUADRUPED_ENABLE_GAIT_ENGINE  // Trot, creep and turn commands return immediately and the gait is computed in the servo interrupt.
 
 #define PIN_BUZZER     3
 
 #if defined(QUADRUPED_HAS_IR_CONTROL)
 #define USE_TINY_IR_RECEIVER // must be specified before including IRCommandDispatcher.hpp to define which IR library to use
 #define IR_INPUT_PIN  A0
+//#define ENABLE_IR_COMMAND_QUEUE // Queue commands received during a move and let the stop command end the move immediately
 #endif
 
 #if defined(QUADRUPED_HAS_US_DISTANCE)
@@ -159,6 +159,9 @@ void setup() {
 
 #if defined(QUADRUPED_HAS_IR_CONTROL)
     IRDispatcher.init();
+#  if defined(ENABLE_IR_COMMAND_QUEUE)
+    IRDispatcher.setStopHandler(&stopAllServos); // End running moves directly at receiving the stop command
+#  endif
     Serial.print(F("Listening to IR remote of type "));
     Serial.print(IR_REMOTE_NAME);
     Serial.println(F(" at pin " STR(IR_INPUT_PIN)));
@@ -219,6 +222,20 @@ void loop() {
      * IR control handling
      */
 #if defined(QUADRUPED_HAS_IR_CONTROL)
+#  if defined(QUADRUPED_ENABLE_GAIT_ENGINE)
+    if (isGaitRunning()) {
+        /*
+         * All other blocking commands require the leg servos, so the gait must stop before.
+         * Trot, creep and turn just change the running gait.
+         */
+        if (IRDispatcher.BlockingCommandToRunNext != COMMAND_EMPTY && IRDispatcher.BlockingCommandToRunNext != COMMAND_TROT
+                && IRDispatcher.BlockingCommandToRunNext != COMMAND_CREEP && IRDispatcher.BlockingCommandToRunNext != COMMAND_TURN) {
+            stopGait();
+            waitForGaitToStop();
+        }
+        IRDispatcher.IRReceivedData.MillisOfLastCode = millis(); // no demo move or attention while walking
+    }
+#  endif
     //Check for IR commands and execute them. Returns only AFTER finishing of requested blocking movement
     if (IRDispatcher.checkAndRunSuspendedBlockingCommands()) {
         delay(50); // for the voltage to stabilize after the blocking movement
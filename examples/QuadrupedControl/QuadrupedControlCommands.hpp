@@ -32,6 +32,9 @@
 #include "QuadrupedControlCommands.h"
 #include "QuadrupedServoControl.hpp"
 #include "QuadrupedBasicMovements.hpp"
+#if defined(QUADRUPED_ENABLE_GAIT_ENGINE)
+#include "QuadrupedGait.hpp"
+#endif
 
 //#define INFO // activate this to see serial info output
 
@@ -72,7 +75,11 @@ void __attribute__((weak)) doTrot() {
     Serial.print(F("Trot"));
     printQuadrupedServoSpeed();
 #endif
+#if defined(QUADRUPED_ENABLE_GAIT_ENGINE)
+    startGait(&TrotGait); // returns immediately
+#else
     moveTrot();
+#endif
 }
 
 void __attribute__((weak)) doCreep() {
@@ -80,7 +87,11 @@ void __attribute__((weak)) doCreep() {
     Serial.print(F("Creep"));
     printQuadrupedServoSpeed();
 #endif
+#if defined(QUADRUPED_ENABLE_GAIT_ENGINE)
+    startGait(&CreepGait); // returns immediately
+#else
     moveCreep();
+#endif
 }
 
 void __attribute__((weak)) doTurn() {
@@ -88,7 +99,11 @@ void __attribute__((weak)) doTurn() {
     Serial.print(F("Turn"));
     printQuadrupedServoSpeed();
 #endif
+#if defined(QUADRUPED_ENABLE_GAIT_ENGINE)
+    startGait(&TurnGait); // returns immediately
+#else
     moveTurn();
+#endif
 }
 
 /*
@@ -346,6 +361,10 @@ void __attribute__((weak)) doQuadrupedAutoMove() {
  * Instant Commands
  *************************/
 void __attribute__((weak)) doStop() {
+#if defined(QUADRUPED_ENABLE_GAIT_ENGINE)
+    stopGait();
+    waitForGaitToStop();
+#endif
     setActionToStop(); // this also stops NeoPatterns
 }
 
@@ -0,0 +1,68 @@
+/*
+ * QuadrupedGait.h
+ *
+ * Phase based gait engine. All 8 leg servos are moved by the ServoEasing interrupt,
+ * so the main loop is free for IR, ultrasonic and NeoPixel handling while walking.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of QuadrupedControl https://github.com/ArminJo/QuadrupedControl.
+ *
+ *  QuadrupedControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _QUADRUPED_GAIT_H
+#define _QUADRUPED_GAIT_H
+
+#include "QuadrupedServoConfiguration.h" // for NUMBER_OF_LEGS
+
+#include <stdint.h>
+
+#if !defined(GAIT_MINIMUM_TRANSITION_MILLIS)
+#define GAIT_MINIMUM_TRANSITION_MILLIS  100 // Minimum duration of the move to the start position of a new gait or direction
+#endif
+
+#define GAIT_FLAG_TURN  0x01 // All pivot servos move in the same direction. Direction left turns left, all other directions turn right.
+
+/*
+ * One period of a gait is one cycle. Within the cycle, each leg is on the ground for DutyFactor/256 of the cycle
+ * and moves its foot StrideAngle degree backwards. For the rest of the cycle the leg swings forward and is lifted
+ * by a parabola with the maximum of LiftAngle degree above body height.
+ * The cycle duration is chosen such that the forward swing of the pivot servos runs with sQuadrupedServoSpeed.
+ */
+struct GaitParameters {
+    uint8_t ActionType;         // ACTION_TYPE_TROT etc. Is set as sCurrentlyRunningAction, e.g. for NeoPixel patterns
+    uint8_t Flags;
+    uint8_t DutyFactor;         // Fraction of the cycle the leg is on the ground in 1/256. 128 -> 50 %
+    uint8_t StrideAngle;        // Pivot angle the foot moves during stance
+    uint8_t LiftAngle;          // Maximum lift angle added to the body height angle during swing
+    uint8_t BaseAngle[NUMBER_OF_LEGS];   // Pivot angle in the middle of the stride for FL, BL, BR, FR
+    uint8_t PhaseOffset[NUMBER_OF_LEGS]; // Start of each leg in the cycle in 1/256 of the cycle
+};
+
+extern const struct GaitParameters TrotGait;
+extern const struct GaitParameters CreepGait;
+extern const struct GaitParameters TurnGait;
+
+/*
+ * All functions return immediately. The gait is running, until stopGait() is called.
+ * A new gait, a new direction, speed or body height is taken at the end of the current cycle.
+ */
+void startGait(const struct GaitParameters *aGaitParametersPGM);
+void stopGait();
+void waitForGaitToStop();
+bool isGaitRunning();
+
+#endif // _QUADRUPED_GAIT_H
@@ -0,0 +1,273 @@
+/*
+ * QuadrupedGait.hpp
+ *
+ * Phase based gait engine. All 8 leg servos are moved by the ServoEasing interrupt,
+ * so the main loop is free for IR, ultrasonic and NeoPixel handling while walking.
+ *
+ * Each leg servo runs one EASE_USER_DIRECT move per gait cycle. The user easing function
+ * computes the angles of all servos from the percentage of completion of the cycle, i.e. from the gait phase.
+ * At the end of a cycle, the TargetPositionReachedHandler of each servo starts the move for the next cycle
+ * without any gap, using the end time of the last cycle as start time of the next one.
+ * Since the angles at the start of a cycle are equal to the angles at the end of a cycle, speed changes are seamless.
+ * A change of gait, direction or body height requires a short linear move to the start position of the new gait.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of QuadrupedControl https://github.com/ArminJo/QuadrupedControl.
+ *
+ *  QuadrupedControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _QUADRUPED_GAIT_HPP
+#define _QUADRUPED_GAIT_HPP
+
+#include <Arduino.h>
+
+#include "QuadrupedGait.h"
+#include "QuadrupedBasicMovements.h"
+#include "QuadrupedServoControl.h"
+
+#if defined(PROVIDE_ONLY_LINEAR_MOVEMENT) || !defined(ENABLE_EASE_USER) || defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
+#error The gait engine requires EASE_USER_DIRECT and the TargetPositionReachedHandler.
+#endif
+
+/*
+ * The gaits. The base angles and phases are given for MOVE_DIRECTION_FORWARD.
+ * Trot: Diagonal legs move together, 2 legs are always on the ground.
+ * Creep: Only one leg is lifted at a time in the order FR, BL, FL, BR. 3 legs are always on the ground.
+ */
+const struct GaitParameters TrotGait PROGMEM = { ACTION_TYPE_TROT, 0, 128, 2 * TROT_MOVE_ANGLE, 40, { TROT_BASE_ANGLE_FL_BR,
+TROT_BASE_ANGLE_BL_FR, TROT_BASE_ANGLE_FL_BR, TROT_BASE_ANGLE_BL_FR }, { 0, 128, 0, 128 } };
+const struct GaitParameters CreepGait PROGMEM = { ACTION_TYPE_CREEP, 0, 192, 40, 40, { TROT_BASE_ANGLE_FL_BR, TROT_BASE_ANGLE_BL_FR,
+TROT_BASE_ANGLE_FL_BR, TROT_BASE_ANGLE_BL_FR }, { 64, 128, 0, 192 } };
+const struct GaitParameters TurnGait PROGMEM = { ACTION_TYPE_TURN, GAIT_FLAG_TURN, 192, 40, 40, { 90, 90, 90, 90 }, { 64, 128, 0,
+        192 } };
+
+#define GAIT_STATE_STOPPED      0
+#define GAIT_STATE_TRANSITION   1 // Moving to the start position of a gait
+#define GAIT_STATE_RUNNING      2
+#define GAIT_STATE_STOPPING     3 // Moving to the stand position
+
+volatile uint8_t sGaitState = GAIT_STATE_STOPPED;
+struct GaitParameters sGaitParameters;              // RAM copy of the running gait
+const struct GaitParameters *sRequestedGaitPGM;     // NULL -> stop requested
+uint8_t sGaitDirection;                             // sMovingDirection of the running gait
+uint8_t sGaitBodyHeightAngle;                       // sRequestedBodyHeightAngle of the running cycle
+uint8_t sGaitMoveIsCycle;                           // false -> next move is a linear transition
+uint16_t sGaitMillisForNextMove;
+uint8_t sGaitServosToRestart;                       // Number of handler calls left for the current end of move
+uint8_t sGaitServoAngles[NUMBER_OF_LEG_SERVOS];     // Angles for the current frame, computed by computeGaitServoAngles()
+uint8_t sGaitNextAngles[NUMBER_OF_LEG_SERVOS];      // Target angles of the next move
+float sLastGaitPercentageOfCompletion;
+
+/*
+ * Compute the angles of all leg servos for one phase of the gait cycle
+ */
+void computeGaitServoAngles(float aPercentageOfCompletion, uint8_t *aServoAngles) {
+    float tDutyFactor = sGaitParameters.DutyFactor / 256.0;
+    for (uint_fast8_t tLegIndex = 0; tLegIndex < NUMBER_OF_LEGS; ++tLegIndex) {
+        float tPhase = aPercentageOfCompletion + (sGaitParameters.PhaseOffset[tLegIndex] / 256.0);
+        if (tPhase >= 1.0) {
+            tPhase -= 1.0;
+        }
+        float tFootPosition; // -0.5 is back and 0.5 is front end of the stride
+        int tLiftAngle = sGaitBodyHeightAngle;
+        if (tPhase < tDutyFactor) {
+            // Stance -> move foot backwards on the ground
+            tFootPosition = 0.5 - (tPhase / tDutyFactor);
+        } else {
+            // Swing -> move foot forward and lift it by a parabola
+            float tSwing = (tPhase - tDutyFactor) / (1.0 - tDutyFactor);
+            tFootPosition = tSwing - 0.5;
+            tLiftAngle += (int) (4.0 * sGaitParameters.LiftAngle * tSwing * (1.0 - tSwing));
+            if (tLiftAngle > LIFT_HIGHEST_ANGLE) {
+                tLiftAngle = LIFT_HIGHEST_ANGLE;
+            }
+        }
+
+        uint8_t tPivotServoIndex;
+        if (sGaitParameters.Flags & GAIT_FLAG_TURN) {
+            tPivotServoIndex = tLegIndex * SERVOS_PER_LEG;
+            if (sGaitDirection != MOVE_DIRECTION_LEFT) {
+                tFootPosition = -tFootPosition;
+            }
+        } else {
+            tPivotServoIndex = transformOneServoIndex(tLegIndex * SERVOS_PER_LEG, sGaitDirection, false);
+            if (tLegIndex <= BACK_LEFT) {
+                // For the left legs, forward is a smaller angle
+                tFootPosition = -tFootPosition;
+            }
+        }
+        aServoAngles[tPivotServoIndex] = sGaitParameters.BaseAngle[tLegIndex] + (int) ((sGaitParameters.StrideAngle * tFootPosition) + 0.5);
+        aServoAngles[tPivotServoIndex + LIFT_SERVO_OFFSET] = tLiftAngle;
+    }
+}
+
+/*
+ * User easing function for all leg servos, called by the ServoEasing interrupt.
+ */
+float computeGaitAngle(float aPercentageOfCompletion, void *aUserDataPointer) {
+    if (aPercentageOfCompletion != sLastGaitPercentageOfCompletion) {
+        // Use a global variable, to do computing only once for all servos of one frame
+        sLastGaitPercentageOfCompletion = aPercentageOfCompletion;
+        computeGaitServoAngles(aPercentageOfCompletion, sGaitServoAngles);
+    }
+    return *((uint8_t*) aUserDataPointer) + EASE_FUNCTION_DEGREE_INDICATOR_OFFSET;
+}
+
+/*
+ * Sets sGaitMillisForNextMove for a linear move from the current target positions to sGaitNextAngles
+ */
+void setGaitTransitionMillis() {
+    int tMaximumDelta = 0;
+    for (uint_fast8_t tServoIndex = 0; tServoIndex < NUMBER_OF_LEG_SERVOS; ++tServoIndex) {
+        int tDelta = abs(sGaitNextAngles[tServoIndex] - (int) ServoEasing::ServoEasingNextPositionArray[tServoIndex]);
+        if (tMaximumDelta < tDelta) {
+            tMaximumDelta = tDelta;
+        }
+    }
+    sGaitMillisForNextMove = (tMaximumDelta * 1000L) / sQuadrupedServoSpeed;
+    if (sGaitMillisForNextMove < GAIT_MINIMUM_TRANSITION_MILLIS) {
+        sGaitMillisForNextMove = GAIT_MINIMUM_TRANSITION_MILLIS;
+    }
+}
+
+/*
+ * Called at the end of a move for the first leg servo. Determines the next move of all leg servos.
+ */
+void prepareNextGaitMove() {
+    sGaitServosToRestart = NUMBER_OF_LEG_SERVOS;
+    sLastGaitPercentageOfCompletion = -1.0; // To force call to computeGaitServoAngles() in easing function
+    uint8_t tRequestedBodyHeightAngle = sRequestedBodyHeightAngle; // sRequestedBodyHeightAngle is volatile
+
+    if (sRequestedGaitPGM == NULL) {
+        if (sGaitState == GAIT_STATE_STOPPING) {
+            // Stand position reached
+            sGaitState = GAIT_STATE_STOPPED;
+            setActionToStop();
+            return;
+        }
+        // Stop requested -> move to stand position
+        for (uint_fast8_t tServoIndex = 0; tServoIndex < NUMBER_OF_LEG_SERVOS; tServoIndex += SERVOS_PER_LEG) {
+            sGaitNextAngles[tServoIndex] = 90;
+            sGaitNextAngles[tServoIndex + LIFT_SERVO_OFFSET] = tRequestedBodyHeightAngle;
+        }
+        setGaitTransitionMillis();
+        sGaitMoveIsCycle = false;
+        sGaitState = GAIT_STATE_STOPPING;
+
+    } else {
+        if (sGaitState == GAIT_STATE_STOPPED || sGaitState == GAIT_STATE_STOPPING || sGaitDirection != sMovingDirection || sGaitBodyHeightAngle != tRequestedBodyHeightAngle
+                || memcmp_P(&sGaitParameters, sRequestedGaitPGM, sizeof(sGaitParameters)) != 0) {
+            // New gait, direction or height -> move linear to start position of the (new) gait
+            memcpy_P(&sGaitParameters, sRequestedGaitPGM, sizeof(sGaitParameters));
+            sGaitDirection = sMovingDirection;
+            sGaitBodyHeightAngle = tRequestedBodyHeightAngle;
+            computeGaitServoAngles(0.0, sGaitNextAngles);
+            setGaitTransitionMillis();
+            sGaitMoveIsCycle = false;
+            sGaitState = GAIT_STATE_TRANSITION;
+        } else {
+            // Next cycle, start and end angles are the same as for the last cycle
+            uint32_t tMillisForCycle = (sGaitParameters.StrideAngle * 256000L)
+                    / ((256 - sGaitParameters.DutyFactor) * (uint32_t) sQuadrupedServoSpeed);
+            sGaitMillisForNextMove = tMillisForCycle;
+            sGaitMoveIsCycle = true;
+            sGaitState = GAIT_STATE_RUNNING;
+        }
+    }
+}
+
+/*
+ * Starts the next move for one servo at the end time of its last move
+ */
+void startNextGaitMove(ServoEasing *aServoEasing) {
+    ServoEasingTimeType tMillisAtEndOfMove = aServoEasing->mMillisAtStartMove + aServoEasing->mMillisForCompleteMove;
+    aServoEasing->setEasingType(sGaitMoveIsCycle ? EASE_USER_DIRECT : EASE_LINEAR);
+    aServoEasing->startEaseToD(sGaitNextAngles[aServoEasing->mServoIndex], sGaitMillisForNextMove, DO_NOT_START_UPDATE_BY_INTERRUPT);
+    aServoEasing->mMillisAtStartMove = tMillisAtEndOfMove;
+#if defined(ENABLE_PACKED_UPDATE_KERNEL)
+    aServoEasing->updatePackedKernelEntry(); // copy the new start time
+#endif
+    aServoEasing->update(); // write the position for this frame, otherwise the servo would stand still for one frame
+}
+
+/*
+ * TargetPositionReachedHandler of all leg servos
+ */
+void handleGaitMoveEnd(ServoEasing *aServoEasing) {
+    if (sGaitServosToRestart == 0) {
+        // First servo of this end of move
+        prepareNextGaitMove();
+    }
+    sGaitServosToRestart--;
+    if (sGaitState == GAIT_STATE_STOPPED) {
+        aServoEasing->setTargetPositionReachedHandler(NULL);
+        aServoEasing->setEasingType(EASE_LINEAR);
+    } else {
+        startNextGaitMove(aServoEasing);
+    }
+}
+
+/*
+ * If a gait is running, the new gait is started at the end of the current cycle
+ */
+void startGait(const struct GaitParameters *aGaitParametersPGM) {
+    sCurrentlyRunningAction = pgm_read_byte(&aGaitParametersPGM->ActionType);
+    noInterrupts();
+    sRequestedGaitPGM = aGaitParametersPGM; // pointer is not atomic on AVR
+    interrupts();
+    if (sGaitState == GAIT_STATE_STOPPED) {
+        sGaitServosToRestart = 0;
+        prepareNextGaitMove();
+        for (uint_fast8_t tServoIndex = 0; tServoIndex < NUMBER_OF_LEG_SERVOS; ++tServoIndex) {
+            ServoEasing *tServo = ServoEasing::ServoEasingArray[tServoIndex];
+            tServo->registerUserEaseInFunction(&computeGaitAngle, &sGaitServoAngles[tServoIndex]);
+            tServo->setTargetPositionReachedHandler(&handleGaitMoveEnd);
+            tServo->setEasingType(EASE_LINEAR);
+            tServo->startEaseToD(sGaitNextAngles[tServoIndex], sGaitMillisForNextMove, DO_NOT_START_UPDATE_BY_INTERRUPT);
+            // all servos must end in the same frame
+            tServo->mMillisAtStartMove = ServoEasing::ServoEasingArray[FRONT_LEFT_PIVOT]->mMillisAtStartMove;
+#if defined(ENABLE_PACKED_UPDATE_KERNEL)
+            tServo->updatePackedKernelEntry(); // copy the new start time
+#endif
+        }
+        sGaitServosToRestart = 0;
+        if (!ServoEasing::sInterruptsAreActive) {
+            enableServoEasingInterrupt();
+        }
+    }
+}
+
+/*
+ * The legs move to the stand position at the end of the current cycle
+ */
+void stopGait() {
+    noInterrupts();
+    sRequestedGaitPGM = NULL;
+    interrupts();
+}
+
+void waitForGaitToStop() {
+    while (sGaitState != GAIT_STATE_STOPPED) {
+        delay(REFRESH_INTERVAL_MILLIS);
+    }
+}
+
+bool isGaitRunning() {
+    return (sGaitState != GAIT_STATE_STOPPED);
+}
+
+#endif // _QUADRUPED_GAIT_HPP
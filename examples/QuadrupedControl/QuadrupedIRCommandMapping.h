@@ -490,7 +490,7 @@ const struct IRToCommandMappingStruct IRMapping[] = {
         { COMMAND_US_LEFT, IR_COMMAND_FLAG_REPEATABLE_NON_BLOCKING, &doUSLeft, ultrasonicServoLeft }, /**/
         { COMMAND_US_SCAN, IR_COMMAND_FLAG_NON_BLOCKING, &doUSScan, ultrasonicServoScan }, /**/
 #endif
-        { COMMAND_STOP, IR_COMMAND_FLAG_BLOCKING, &doStop, stop },
+        { COMMAND_STOP, IR_COMMAND_FLAG_BLOCKING | IR_COMMAND_FLAG_STOP, &doStop, stop },
         { COMMAND_PAUSE_RESUME, IR_COMMAND_FLAG_NON_BLOCKING, &doPauseResume, pauseResume }, /**/
         { COMMAND_DEMO, IR_COMMAND_FLAG_BLOCKING, &doQuadrupedDemoMove, demo }, /**/
         { COMMAND_PATTERN_1, IR_COMMAND_FLAG_NON_BLOCKING, &doPattern1, pattern }, /**/
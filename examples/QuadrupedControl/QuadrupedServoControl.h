@@ -80,6 +80,8 @@ uint8_t convertLegPercentHeightToAngle(uint8_t aLegHeightPercent);
 /*
  * Main transformation functions
  */
+void transformAndSetServoVector(const int *aServoAngles, uint8_t aDirection = MOVE_DIRECTION_FORWARD, bool doMirror = false,
+        bool aSetLiftServos = true);
 void transformAndSetAllServos(int aFrontLeftPivot, int aBackLeftPivot, int aBackRightPivot, int aFrontRightPivot,
         int aFrontLeftLift, int aBackLeftLift, int aBackRightLift, int aFrontRightLift, uint8_t aDirection =
         MOVE_DIRECTION_FORWARD, bool doMirror = false, bool aDoMove = true);
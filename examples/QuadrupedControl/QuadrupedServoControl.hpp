@@ -180,57 +180,49 @@ void setEasingTypeForMoving() {
  * Direction forward changes nothing.
  * Direction backward swaps forward and backward servos / increases index by NUMBER_OF_LEGS/2
  * Direction left increases index by 1 and right by 3.
- * Mirroring swaps left and right (XOR with 0x06) and invert all angles.
+ * Mirroring swaps left and right (XOR with 0x06, or 0x02 for side directions) and invert all angles.
+ *
+ * All 8 transformations are precomputed in LegTransformTable, which is indexed by (doMirror * 4) + aDirection and leg index.
+ * An entry contains the index of the pivot servo for this leg, the lift servo is the next one.
+ * LEG_TRANSFORM_INVERT_PIVOT is set, if the pivot angle must be inverted (180 - angle).
+ */
+#define LEG_TRANSFORM_SERVO_INDEX_MASK  0x07
+#define LEG_TRANSFORM_INVERT_PIVOT      0x80
+const uint8_t LegTransformTable[2 * NUMBER_OF_LEGS][NUMBER_OF_LEGS] PROGMEM = {
+        /* forward */{ 0, 2, 4, 6 }, /* left */{ 2, 4, 6, 0 }, /* backward */{ 4, 6, 0, 2 }, /* right */{ 6, 0, 2, 4 },
+        /* mirrored forward */{ LEG_TRANSFORM_INVERT_PIVOT | 6, LEG_TRANSFORM_INVERT_PIVOT | 4, LEG_TRANSFORM_INVERT_PIVOT | 2, LEG_TRANSFORM_INVERT_PIVOT | 0 },
+        /* mirrored left */{ LEG_TRANSFORM_INVERT_PIVOT | 0, LEG_TRANSFORM_INVERT_PIVOT | 6, LEG_TRANSFORM_INVERT_PIVOT | 4, LEG_TRANSFORM_INVERT_PIVOT | 2 },
+        /* mirrored backward */{ LEG_TRANSFORM_INVERT_PIVOT | 2, LEG_TRANSFORM_INVERT_PIVOT | 0, LEG_TRANSFORM_INVERT_PIVOT | 6, LEG_TRANSFORM_INVERT_PIVOT | 4 },
+        /* mirrored right */{ LEG_TRANSFORM_INVERT_PIVOT | 4, LEG_TRANSFORM_INVERT_PIVOT | 2, LEG_TRANSFORM_INVERT_PIVOT | 0, LEG_TRANSFORM_INVERT_PIVOT | 6 } };
+
+/*
+ * Writes a vector of 8 servo angles in the order FL pivot, FL lift, BL pivot, BL lift, BR pivot ... FR lift
+ * to ServoEasingNextPositionArray in one pass.
+ * @param aSetLiftServos if false, only the pivot angles are taken and the lift servos are not changed
  */
-uint8_t getMirrorXorMask(uint8_t aDirection) {
-// XOR the index with this value to get the mirrored index
-    if (aDirection & MOVE_DIRECTION_SIDE_MASK) {
-        return 0x2;
-    } else {
-        return 0x6;
+void transformAndSetServoVector(const int *aServoAngles, uint8_t aDirection, bool doMirror, bool aSetLiftServos) {
+    const uint8_t *tLegTransformPGM = LegTransformTable[(doMirror * NUMBER_OF_LEGS) + (aDirection & MOVE_DIRECTION_MASK)];
+    for (uint_fast8_t tLegIndex = 0; tLegIndex < NUMBER_OF_LEGS; ++tLegIndex) {
+        uint8_t tLegTransform = pgm_read_byte(tLegTransformPGM++);
+        uint8_t tEffectivePivotServoIndex = tLegTransform & LEG_TRANSFORM_SERVO_INDEX_MASK;
+        int tPivotAngle = *aServoAngles++;
+        if (tLegTransform & LEG_TRANSFORM_INVERT_PIVOT) {
+            tPivotAngle = 180 - tPivotAngle;
+        }
+        ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = tPivotAngle;
+        int tLiftAngle = *aServoAngles++;
+        if (aSetLiftServos) {
+            ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex + LIFT_SERVO_OFFSET] = tLiftAngle;
+        }
     }
 }
+
 void transformAndSetAllServos(int aFrontLeftPivot, int aBackLeftPivot, int aBackRightPivot, int aFrontRightPivot,
         int aFrontLeftLift, int aBackLeftLift, int aBackRightLift, int aFrontRightLift, uint8_t aDirection, bool doMirror,
         bool aDoMove) {
-    uint8_t tIndexToAdd = aDirection * SERVOS_PER_LEG;
-    uint8_t tXorToGetMirroredIndex = 0x0;
-// Invert angles for pivot servos
-    bool doInvert = false;
-    if (doMirror) {
-// XOR the index with this value to get the mirrored index
-        tXorToGetMirroredIndex = getMirrorXorMask(aDirection);
-        doInvert = true;
-    }
-
-    uint8_t tEffectivePivotServoIndex;
-    tEffectivePivotServoIndex = ((FRONT_LEFT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aFrontLeftPivot = 180 - aFrontLeftPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aFrontLeftPivot;
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex + LIFT_SERVO_OFFSET] = aFrontLeftLift;
-
-    tEffectivePivotServoIndex = ((BACK_LEFT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aBackLeftPivot = 180 - aBackLeftPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aBackLeftPivot;
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex + LIFT_SERVO_OFFSET] = aBackLeftLift;
-
-    tEffectivePivotServoIndex = ((BACK_RIGHT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aBackRightPivot = 180 - aBackRightPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aBackRightPivot;
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex + LIFT_SERVO_OFFSET] = aBackRightLift;
-
-    tEffectivePivotServoIndex = ((FRONT_RIGHT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aFrontRightPivot = 180 - aFrontRightPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aFrontRightPivot;
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex + LIFT_SERVO_OFFSET] = aFrontRightLift;
+    int tServoAngles[NUMBER_OF_LEG_SERVOS] = { aFrontLeftPivot, aFrontLeftLift, aBackLeftPivot, aBackLeftLift, aBackRightPivot,
+            aBackRightLift, aFrontRightPivot, aFrontRightLift };
+    transformAndSetServoVector(tServoAngles, aDirection, doMirror, true);
 
     if (aDoMove) {
         synchronizeMoveAllServosAndCheckInputAndWait();
@@ -242,40 +234,8 @@ void transformAndSetAllServos(int aFrontLeftPivot, int aBackLeftPivot, int aBack
  */
 void transformAndSetPivotServos(int aFrontLeftPivot, int aBackLeftPivot, int aBackRightPivot, int aFrontRightPivot,
         uint8_t aDirection, bool doMirror, bool aDoMove) {
-    uint8_t tIndexToAdd = aDirection * SERVOS_PER_LEG;
-    uint8_t tXorToGetMirroredIndex = 0x0;
-// Invert angles for pivot servos
-    bool doInvert = false;
-    if (doMirror) {
-// XOR the index with this value to get the mirrored index
-        tXorToGetMirroredIndex = getMirrorXorMask(aDirection);
-        doInvert = true;
-    }
-
-    uint8_t tEffectivePivotServoIndex;
-    tEffectivePivotServoIndex = ((FRONT_LEFT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aFrontLeftPivot = 180 - aFrontLeftPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aFrontLeftPivot;
-
-    tEffectivePivotServoIndex = ((BACK_LEFT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aBackLeftPivot = 180 - aBackLeftPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aBackLeftPivot;
-
-    tEffectivePivotServoIndex = ((BACK_RIGHT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aBackRightPivot = 180 - aBackRightPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aBackRightPivot;
-
-    tEffectivePivotServoIndex = ((FRONT_RIGHT_PIVOT + tIndexToAdd) % NUMBER_OF_LEG_SERVOS) ^ tXorToGetMirroredIndex;
-    if (doInvert) {
-        aFrontRightPivot = 180 - aFrontRightPivot;
-    }
-    ServoEasing::ServoEasingNextPositionArray[tEffectivePivotServoIndex] = aFrontRightPivot;
+    int tServoAngles[NUMBER_OF_LEG_SERVOS] = { aFrontLeftPivot, 0, aBackLeftPivot, 0, aBackRightPivot, 0, aFrontRightPivot, 0 };
+    transformAndSetServoVector(tServoAngles, aDirection, doMirror, false);
 
     if (aDoMove) {
         synchronizeMoveAllServosAndCheckInputAndWait();
@@ -286,11 +246,9 @@ void transformAndSetPivotServos(int aFrontLeftPivot, int aBackLeftPivot, int aBa
  * Transform index of servo by direction and mirroring
  */
 uint8_t transformOneServoIndex(uint8_t aServoIndexToTransform, uint8_t aDirection, bool doMirror) {
-    if (doMirror) {
-        // XOR the index with this value in order to get the mirrored index
-        return ((aServoIndexToTransform + (aDirection * SERVOS_PER_LEG)) % NUMBER_OF_LEG_SERVOS) ^ getMirrorXorMask(aDirection);
-    }
-    return ((aServoIndexToTransform + (aDirection * SERVOS_PER_LEG)) % NUMBER_OF_LEG_SERVOS);
+    uint8_t tLegTransform = pgm_read_byte(
+            &LegTransformTable[(doMirror * NUMBER_OF_LEGS) + (aDirection & MOVE_DIRECTION_MASK)][aServoIndexToTransform / SERVOS_PER_LEG]);
+    return (tLegTransform & LEG_TRANSFORM_SERVO_INDEX_MASK) + (aServoIndexToTransform % SERVOS_PER_LEG);
 }
 
 void testTransform() {
@@ -0,0 +1,528 @@
+/*
+ * ClockDigitTimelines.h
+ *
+ * Servo angles of the strokes of drawNumber() for all digit positions, played by the ServoEasing timeline player.
+ * Each digit starts at the origin of the digit position with lifted pen. Servo 0 is the pivot, 1 the horizontal and 2 the lift servo.
+ * If you change the geometry in ClockMovements.h or RobotArmServoConfiguration.h or the speed,
+ * activate GENERATE_CLOCK_DIGIT_TIMELINES, call printClockDigitTimelines() and replace the tables below with the output.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _CLOCK_DIGIT_TIMELINES_H
+#define _CLOCK_DIGIT_TIMELINES_H
+
+#include <Arduino.h>
+#include "ClockMovements.h"
+
+// Generated by printClockDigitTimelines() for 80 millimeter per second
+const uint16_t ClockDigitTimelineIndex[10] PROGMEM = {
+0, 57, 114, 178, 263, 341, 412, 490, 547, 632, };
+#define CLOCK_DIGIT_TIMELINES_SIZE 703
+const int8_t ClockDigitEndOffset[10][2] PROGMEM = {
+{ 0, 0 }, { 25, 0 }, { 25, 0 }, { 25, 25 }, { 25, 0 }, { 0, 0 }, { 0, 25 }, { 13, 0 }, { 25, 25 }, { 0, 0 }, };
+const uint16_t ClockDigitTimelines[CLOCK_NUMBER_OF_DIGIT_POSITIONS][CLOCK_DIGIT_TIMELINES_SIZE] PROGMEM = {
+{
+    // 0
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 4, (uint16_t) -48,
+    TIMELINE_END,
+    // 1
+    TIMELINE_KEYFRAME(0, 200, 0x07, EASE_LINEAR), (uint16_t) -18, 14, (uint16_t) -45,
+    TIMELINE_KEYFRAME(200, 200, 0x07, EASE_LINEAR), (uint16_t) -16, 22, (uint16_t) -42,
+    TIMELINE_KEYFRAME(200, 187, 0x07, EASE_LINEAR), (uint16_t) -16, 31, (uint16_t) -52,
+    TIMELINE_KEYFRAME(187, 192, 0x07, EASE_LINEAR), (uint16_t) -19, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(192, 192, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(192, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -30, 11, (uint16_t) -46,
+    TIMELINE_END,
+    // 2
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -30, 11, (uint16_t) -46,
+    TIMELINE_END,
+    // 3
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 4, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -25, 24, (uint16_t) -41,
+    TIMELINE_END,
+    // 4
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -30, 11, (uint16_t) -46,
+    TIMELINE_END,
+    // 5
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), (uint16_t) -21, 16, (uint16_t) -45,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -21, 26, (uint16_t) -40,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 4, (uint16_t) -48,
+    TIMELINE_END,
+    // 6
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), (uint16_t) -21, 16, (uint16_t) -45,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -21, 26, (uint16_t) -40,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_END,
+    // 7
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 214, 0x07, EASE_LINEAR), (uint16_t) -23, 35, (uint16_t) -48,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), (uint16_t) -24, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), (uint16_t) -25, 19, (uint16_t) -61,
+    TIMELINE_KEYFRAME(214, 187, 0x07, EASE_LINEAR), (uint16_t) -25, 8, (uint16_t) -47,
+    TIMELINE_END,
+    // 8
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 4, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -25, 24, (uint16_t) -41,
+    TIMELINE_END,
+    // 9
+    TIMELINE_KEYFRAME(0, 220, 0x07, EASE_LINEAR), (uint16_t) -23, 14, (uint16_t) -45,
+    TIMELINE_KEYFRAME(220, 220, 0x07, EASE_LINEAR), (uint16_t) -25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(220, 187, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -20, 4, (uint16_t) -48,
+    TIMELINE_END,
+},
+{
+    // 0
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 1
+    TIMELINE_KEYFRAME(0, 200, 0x07, EASE_LINEAR), (uint16_t) -4, 10, (uint16_t) -47,
+    TIMELINE_KEYFRAME(200, 200, 0x07, EASE_LINEAR), (uint16_t) -3, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(200, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(187, 192, 0x07, EASE_LINEAR), (uint16_t) -7, 33, (uint16_t) -50,
+    TIMELINE_KEYFRAME(192, 192, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(192, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -16, 2, (uint16_t) -48,
+    TIMELINE_END,
+    // 2
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -16, 2, (uint16_t) -48,
+    TIMELINE_END,
+    // 3
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 0, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -13, 17, (uint16_t) -44,
+    TIMELINE_END,
+    // 4
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -16, 2, (uint16_t) -48,
+    TIMELINE_END,
+    // 5
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), (uint16_t) -7, 11, (uint16_t) -47,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -9, 21, (uint16_t) -42,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 6
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), (uint16_t) -7, 11, (uint16_t) -47,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -9, 21, (uint16_t) -42,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), (uint16_t) -11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_END,
+    // 7
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 214, 0x07, EASE_LINEAR), (uint16_t) -11, 30, (uint16_t) -53,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), (uint16_t) -11, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), (uint16_t) -10, 14, (uint16_t) -64,
+    TIMELINE_KEYFRAME(214, 187, 0x07, EASE_LINEAR), (uint16_t) -10, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 8
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 0, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -13, 17, (uint16_t) -44,
+    TIMELINE_END,
+    // 9
+    TIMELINE_KEYFRAME(0, 220, 0x07, EASE_LINEAR), (uint16_t) -9, 8, (uint16_t) -47,
+    TIMELINE_KEYFRAME(220, 220, 0x07, EASE_LINEAR), (uint16_t) -13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(220, 187, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), (uint16_t) -4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), (uint16_t) -4, 0, (uint16_t) -48,
+    TIMELINE_END,
+},
+{
+    // 0
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 16, 2, (uint16_t) -48,
+    TIMELINE_END,
+    // 1
+    TIMELINE_KEYFRAME(0, 200, 0x07, EASE_LINEAR), 14, 12, (uint16_t) -46,
+    TIMELINE_KEYFRAME(200, 200, 0x07, EASE_LINEAR), 12, 21, (uint16_t) -42,
+    TIMELINE_KEYFRAME(200, 187, 0x07, EASE_LINEAR), 12, 30, (uint16_t) -53,
+    TIMELINE_KEYFRAME(187, 192, 0x07, EASE_LINEAR), 7, 33, (uint16_t) -50,
+    TIMELINE_KEYFRAME(192, 192, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(192, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 4, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 2
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 4, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 3
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 16, 2, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 3, 15, (uint16_t) -45,
+    TIMELINE_END,
+    // 4
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 4, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 5
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), 11, 11, (uint16_t) -46,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 6, 20, (uint16_t) -43,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 16, 2, (uint16_t) -48,
+    TIMELINE_END,
+    // 6
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), 11, 11, (uint16_t) -46,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 6, 20, (uint16_t) -43,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 3, 29, (uint16_t) -38,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_END,
+    // 7
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 31, (uint16_t) -37,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 214, 0x07, EASE_LINEAR), 5, 29, (uint16_t) -54,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), 7, 21, (uint16_t) -59,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), 10, 14, (uint16_t) -64,
+    TIMELINE_KEYFRAME(214, 187, 0x07, EASE_LINEAR), 10, 0, (uint16_t) -48,
+    TIMELINE_END,
+    // 8
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 16, 2, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 13, 17, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 3, 15, (uint16_t) -45,
+    TIMELINE_END,
+    // 9
+    TIMELINE_KEYFRAME(0, 220, 0x07, EASE_LINEAR), 9, 8, (uint16_t) -47,
+    TIMELINE_KEYFRAME(220, 220, 0x07, EASE_LINEAR), 3, 15, (uint16_t) -45,
+    TIMELINE_KEYFRAME(220, 187, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 13, 27, (uint16_t) -55,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 11, 38, (uint16_t) -45,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 3, 25, (uint16_t) -57,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 4, 13, (uint16_t) -65,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 16, 15, (uint16_t) -64,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 16, 2, (uint16_t) -48,
+    TIMELINE_END,
+},
+{
+    // 0
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 30, 11, (uint16_t) -46,
+    TIMELINE_END,
+    // 1
+    TIMELINE_KEYFRAME(0, 200, 0x07, EASE_LINEAR), 27, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(200, 200, 0x07, EASE_LINEAR), 24, 27, (uint16_t) -39,
+    TIMELINE_KEYFRAME(200, 187, 0x07, EASE_LINEAR), 24, 35, (uint16_t) -48,
+    TIMELINE_KEYFRAME(187, 192, 0x07, EASE_LINEAR), 19, 37, (uint16_t) -47,
+    TIMELINE_KEYFRAME(192, 192, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(192, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 20, 4, (uint16_t) -48,
+    TIMELINE_END,
+    // 2
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 20, 4, (uint16_t) -48,
+    TIMELINE_END,
+    // 3
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 30, 11, (uint16_t) -46,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 17, 19, (uint16_t) -43,
+    TIMELINE_END,
+    // 4
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 20, 4, (uint16_t) -48,
+    TIMELINE_END,
+    // 5
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), 24, 18, (uint16_t) -44,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 19, 25, (uint16_t) -40,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 30, 11, (uint16_t) -46,
+    TIMELINE_END,
+    // 6
+    TIMELINE_KEYFRAME(0, 232, 0x07, EASE_LINEAR), 24, 18, (uint16_t) -44,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 19, 25, (uint16_t) -40,
+    TIMELINE_KEYFRAME(232, 232, 0x07, EASE_LINEAR), 14, 32, (uint16_t) -36,
+    TIMELINE_KEYFRAME(232, 187, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_END,
+    // 7
+    TIMELINE_KEYFRAME(0, 312, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 37, (uint16_t) -32,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 214, 0x07, EASE_LINEAR), 17, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), 21, 25, (uint16_t) -56,
+    TIMELINE_KEYFRAME(214, 214, 0x07, EASE_LINEAR), 25, 19, (uint16_t) -61,
+    TIMELINE_KEYFRAME(214, 187, 0x07, EASE_LINEAR), 25, 7, (uint16_t) -47,
+    TIMELINE_END,
+    // 8
+    TIMELINE_KEYFRAME(0, 187, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 30, 11, (uint16_t) -46,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 25, 24, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 17, 19, (uint16_t) -43,
+    TIMELINE_END,
+    // 9
+    TIMELINE_KEYFRAME(0, 220, 0x07, EASE_LINEAR), 23, 14, (uint16_t) -45,
+    TIMELINE_KEYFRAME(220, 220, 0x07, EASE_LINEAR), 17, 19, (uint16_t) -43,
+    TIMELINE_KEYFRAME(220, 187, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(187, 312, 0x07, EASE_LINEAR), 25, 32, (uint16_t) -51,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 22, 43, (uint16_t) -41,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 14, 39, (uint16_t) -44,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 17, 28, (uint16_t) -54,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 20, 17, (uint16_t) -63,
+    TIMELINE_KEYFRAME(312, 312, 0x07, EASE_LINEAR), 30, 22, (uint16_t) -59,
+    TIMELINE_KEYFRAME(312, 187, 0x07, EASE_LINEAR), 30, 11, (uint16_t) -46,
+    TIMELINE_END,
+},
+};
+
+#endif // _CLOCK_DIGIT_TIMELINES_H
@@ -47,6 +47,7 @@
 #define CLOCK_DIGITS_Y          (120) // see MAX_X_VALUE_FOR_GROUND
 #define CLOCK_DIGIT_HEIGHT       (50)
 #define CLOCK_DIGITS_Z           (DRAW_SURFACE_Z - 5)
+#define CLOCK_PEN_LIFTED_Z       (CLOCK_DIGITS_Z + PEN_GRIP_OFFSET + LIFT_HEIGHT)
 
 // Position left side of number
 #define CLOCK_HOUR_ONES_X       (-(CLOCK_DIGIT_WIDTH + CLOCK_DIGIT_MARGIN_X))
@@ -58,6 +59,9 @@
 #define DIGIT_MINUTES_TENS      1
 #define DIGIT_HOUR_ONES         2
 #define DIGIT_HOUR_TENS         3
+#define CLOCK_NUMBER_OF_DIGIT_POSITIONS 4
+
+#define CLOCK_TIMELINE_MILLIMETER_PER_KEYFRAME 25 // Lines are split into keyframes of this length, since the servos move linear in joint space. Deviation is below the 1 degree resolution.
 
 #define CLAW_HEIGHT             (10) // the height of the claw used to be safe above the pen before grabbing
 
@@ -97,5 +101,8 @@ void doErase(uint8_t aDigitPosition);
 void drawNumber(uint8_t aNumber);
 void drawNumber(uint8_t aDigitPosition, uint8_t aNumber);
 void drawTime(uint_fast8_t aHour, uint_fast8_t aMinute, bool aForceDrawing);
+#if defined(GENERATE_CLOCK_DIGIT_TIMELINES)
+void printClockDigitTimelines();
+#endif
 
 #endif // _CLOCK_MOVEMENTS_H
@@ -30,13 +30,19 @@
 
 #include "ClockMovements.h"
 #include "RobotArmServoControl.h"
+#if defined(USE_CARTESIAN_PATH_PLANNER)
+#include "RobotArmPathPlanner.h"
+#endif
+#if defined(USE_CLOCK_DIGIT_TIMELINES)
+#include "ClockDigitTimelines.h"
+#endif
 
 #if defined(INFO) && !defined(LOCAL_INFO)
 #define LOCAL_INFO
 #else
 //#define LOCAL_INFO // This enables info output only for this file
 #endif
-#if defined(LOCAL_INFO)
+#if defined(LOCAL_INFO) && !defined(GENERATE_CLOCK_DIGIT_TIMELINES) // Generated output must not contain info
 #define CLOCK_INFO_PRINT(...)    Serial.print(__VA_ARGS__)
 #define CLOCK_INFO_PRINTLN(...)  Serial.println(__VA_ARGS__)
 #else
@@ -58,14 +64,157 @@ void lower() {
     goToPositionRelative(0, 0, - LIFT_HEIGHT);
 }
 
+#if defined(GENERATE_CLOCK_DIGIT_TIMELINES)
+struct ArmPosition sRecordedPosition; // End of the last recorded keyframe
+uint16_t sMillisOfLastRecordedKeyframe;
+uint16_t sNumberOfRecordedWords;
+bool sPrintRecordedKeyframes;
+
+/*
+ * Negative values must be casted, since the table is of type uint16_t
+ */
+void printTimelineValue(int aDegree) {
+    Serial.print(F(", "));
+    if (aDegree < 0) {
+        Serial.print(F("(uint16_t) "));
+    }
+    Serial.print(aDegree);
+}
+
+/*
+ * Prints the keyframes for a line from sRecordedPosition to the new position.
+ * The line is split into keyframes of at most CLOCK_TIMELINE_MILLIMETER_PER_KEYFRAME, which are linear in joint space.
+ */
+void recordKeyframes(float aLeftRight, float aBackFront, float aDownUp) {
+    float tDeltaLeftRight = aLeftRight - sRecordedPosition.LeftRight;
+    float tDeltaBackFront = aBackFront - sRecordedPosition.BackFront;
+    float tDeltaDownUp = aDownUp - sRecordedPosition.DownUp;
+    float tLength = sqrt(
+            (tDeltaLeftRight * tDeltaLeftRight) + (tDeltaBackFront * tDeltaBackFront) + (tDeltaDownUp * tDeltaDownUp));
+    if (tLength < 0.5) {
+        return; // e.g. liftPen() if pen is already lifted
+    }
+    uint_fast8_t tNumberOfKeyframes = ceil(tLength / CLOCK_TIMELINE_MILLIMETER_PER_KEYFRAME);
+    uint16_t tMillisForKeyframe = ((tLength / tNumberOfKeyframes) * 1000) / sRobotArmServoSpeed;
+
+    struct ArmPosition tStartPosition = sRecordedPosition;
+    for (uint_fast8_t i = 1; i <= tNumberOfKeyframes; ++i) {
+        sRecordedPosition.LeftRight = tStartPosition.LeftRight + ((tDeltaLeftRight * i) / tNumberOfKeyframes);
+        sRecordedPosition.BackFront = tStartPosition.BackFront + ((tDeltaBackFront * i) / tNumberOfKeyframes);
+        sRecordedPosition.DownUp = tStartPosition.DownUp + ((tDeltaDownUp * i) / tNumberOfKeyframes);
+        doInverseKinematics(&sRecordedPosition);
+        if (sPrintRecordedKeyframes) {
+            Serial.print(F("    TIMELINE_KEYFRAME("));
+            Serial.print(sMillisOfLastRecordedKeyframe);
+            Serial.print(F(", "));
+            Serial.print(tMillisForKeyframe);
+            Serial.print(F(", 0x07, EASE_LINEAR)"));
+            printTimelineValue(sRecordedPosition.LeftRightDegree);
+            printTimelineValue(sRecordedPosition.BackFrontDegree);
+            printTimelineValue(sRecordedPosition.DownUpDegree);
+            Serial.println(F(","));
+        }
+        sMillisOfLastRecordedKeyframe = tMillisForKeyframe;
+        sNumberOfRecordedWords += 4 + 3;
+    }
+}
+
+/*
+ * Records the strokes of drawNumber(), starting at the origin of the digit with lifted pen
+ */
+void recordDigit(uint8_t aDigitPosition, uint8_t aNumber) {
+    const int tDigitPositionX[CLOCK_NUMBER_OF_DIGIT_POSITIONS] = { CLOCK_MINUTES_ONES_X, CLOCK_MINUTES_TENS_X, CLOCK_HOUR_ONES_X,
+    CLOCK_HOUR_TENS_X };
+    sRecordedPosition.LeftRight = tDigitPositionX[aDigitPosition];
+    sRecordedPosition.BackFront = CLOCK_DIGITS_Y;
+    sRecordedPosition.DownUp = CLOCK_PEN_LIFTED_Z;
+    sMillisOfLastRecordedKeyframe = 0;
+    drawNumber(aNumber);
+    sNumberOfRecordedWords++; // for TIMELINE_END
+}
+
+/*
+ * Prints the content of ClockDigitTimelines.h for the current geometry and speed.
+ * The first pass only computes the sizes, the index of each digit and the end positions,
+ * which are the same for all digit positions.
+ */
+void printClockDigitTimelines() {
+    Serial.print(F("// Generated by printClockDigitTimelines() for "));
+    Serial.print(sRobotArmServoSpeed);
+    Serial.println(F(" millimeter per second"));
+    Serial.println(F("const uint16_t ClockDigitTimelineIndex[10] PROGMEM = {"));
+    sPrintRecordedKeyframes = false;
+    sNumberOfRecordedWords = 0;
+    for (uint_fast8_t tNumber = 0; tNumber < 10; ++tNumber) {
+        Serial.print(sNumberOfRecordedWords);
+        Serial.print(F(", "));
+        recordDigit(0, tNumber);
+    }
+    Serial.println(F("};"));
+    Serial.print(F("#define CLOCK_DIGIT_TIMELINES_SIZE "));
+    Serial.println(sNumberOfRecordedWords);
+
+    Serial.println(F("const int8_t ClockDigitEndOffset[10][2] PROGMEM = {"));
+    for (uint_fast8_t tNumber = 0; tNumber < 10; ++tNumber) {
+        recordDigit(0, tNumber);
+        Serial.print(F("{ "));
+        Serial.print((int) (sRecordedPosition.LeftRight - CLOCK_MINUTES_ONES_X));
+        Serial.print(F(", "));
+        Serial.print((int) (sRecordedPosition.BackFront - CLOCK_DIGITS_Y));
+        Serial.print(F(" }, "));
+    }
+    Serial.println(F("};"));
+
+    sPrintRecordedKeyframes = true;
+    Serial.println(F("const uint16_t ClockDigitTimelines[CLOCK_NUMBER_OF_DIGIT_POSITIONS][CLOCK_DIGIT_TIMELINES_SIZE] PROGMEM = {"));
+    for (uint_fast8_t tDigitPosition = 0; tDigitPosition < CLOCK_NUMBER_OF_DIGIT_POSITIONS; ++tDigitPosition) {
+        Serial.println(F("{"));
+        for (uint_fast8_t tNumber = 0; tNumber < 10; ++tNumber) {
+            Serial.print(F("    // "));
+            Serial.println(tNumber);
+            recordDigit(tDigitPosition, tNumber);
+            Serial.println(F("    TIMELINE_END,"));
+        }
+        Serial.println(F("},"));
+    }
+    Serial.println(F("};"));
+}
+#endif
+
+/*
+ * With the path planner, the strokes are queued and drawn without stopping at each corner
+ */
+void moveToPosition(int aLeftRightMillimeter, int aBackFrontMillimeter, int aDownUpMillimeter) {
+#if defined(GENERATE_CLOCK_DIGIT_TIMELINES)
+    recordKeyframes((aLeftRightMillimeter == KEEP_POSITION) ? sRecordedPosition.LeftRight : aLeftRightMillimeter,
+            (aBackFrontMillimeter == KEEP_POSITION) ? sRecordedPosition.BackFront : aBackFrontMillimeter,
+            (aDownUpMillimeter == KEEP_POSITION) ? sRecordedPosition.DownUp : aDownUpMillimeter);
+#elif defined(USE_CARTESIAN_PATH_PLANNER)
+    queueLineTo(aLeftRightMillimeter, aBackFrontMillimeter, aDownUpMillimeter);
+#else
+    goToPosition(aLeftRightMillimeter, aBackFrontMillimeter, aDownUpMillimeter);
+#endif
+}
+
+void moveToPositionRelative(int aLeftRightDeltaMilliMeter, int aBackFrontDeltaMilliMeter, int aDownUpDeltaMilliMeter) {
+#if defined(GENERATE_CLOCK_DIGIT_TIMELINES)
+    recordKeyframes(sRecordedPosition.LeftRight + aLeftRightDeltaMilliMeter, sRecordedPosition.BackFront + aBackFrontDeltaMilliMeter,
+            sRecordedPosition.DownUp + aDownUpDeltaMilliMeter);
+#elif defined(USE_CARTESIAN_PATH_PLANNER)
+    queueLineRelative(aLeftRightDeltaMilliMeter, aBackFrontDeltaMilliMeter, aDownUpDeltaMilliMeter);
+#else
+    goToPositionRelative(aLeftRightDeltaMilliMeter, aBackFrontDeltaMilliMeter, aDownUpDeltaMilliMeter);
+#endif
+}
+
 void liftPen() {
     CLOCK_INFO_PRINTLN(F("Lift pen"));
-    goToPosition(KEEP_POSITION, KEEP_POSITION, CLOCK_DIGITS_Z + PEN_GRIP_OFFSET + LIFT_HEIGHT);
+    moveToPosition(KEEP_POSITION, KEEP_POSITION, CLOCK_PEN_LIFTED_Z);
 }
 
 void lowerPen() {
     CLOCK_INFO_PRINTLN(F("Lower pen"));
-    goToPosition(KEEP_POSITION, KEEP_POSITION, CLOCK_DIGITS_Z + PEN_GRIP_OFFSET);
+    moveToPosition(KEEP_POSITION, KEEP_POSITION, CLOCK_DIGITS_Z + PEN_GRIP_OFFSET);
 }
 
 void doDrawNumberOutline() {
@@ -271,104 +420,130 @@ void drawNumber(uint8_t aNumber) {
     case 0:
         // draw clockwise
         lowerPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     case 1:
-        goToPositionRelative(0, (CLOCK_DIGIT_HEIGHT / 3) * 2, 0);
+        moveToPositionRelative(0, (CLOCK_DIGIT_HEIGHT / 3) * 2, 0);
         lowerPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT - ((CLOCK_DIGIT_HEIGHT / 3) * 2), 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT - ((CLOCK_DIGIT_HEIGHT / 3) * 2), 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
         break;
     case 2:
         liftPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
         lowerPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     case 3:
         liftPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
         lowerPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
         liftPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
         lowerPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     case 4:
         liftPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
         lowerPen();
-        goToPositionRelative(0, -(CLOCK_DIGIT_HEIGHT / 2), 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -(CLOCK_DIGIT_HEIGHT / 2), 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
         liftPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
         lowerPen();
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
         break;
     case 5:
         liftPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT, 0);
         lowerPen();
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     case 6:
         liftPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT, 0);
         lowerPen();
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     case 7:
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
         lowerPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative((-CLOCK_DIGIT_WIDTH / 2), -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative((-CLOCK_DIGIT_WIDTH / 2), -CLOCK_DIGIT_HEIGHT, 0);
         break;
     case 8:
         // draw clockwise
         lowerPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
         liftPen();
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
         lowerPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     case 9:
         liftPen();
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, CLOCK_DIGIT_HEIGHT / 2, 0);
         lowerPen();
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
-        goToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
-        goToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
-        goToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, CLOCK_DIGIT_HEIGHT / 2, 0);
+        moveToPositionRelative(CLOCK_DIGIT_WIDTH, 0, 0);
+        moveToPositionRelative(0, -CLOCK_DIGIT_HEIGHT, 0);
+        moveToPositionRelative(-CLOCK_DIGIT_WIDTH, 0, 0);
         break;
     default:
         break;
     }
     liftPen();
+#if defined(USE_CARTESIAN_PATH_PLANNER) && !defined(GENERATE_CLOCK_DIGIT_TIMELINES)
+    waitForPathPlannerToStop();
+#endif
+}
 
+#if defined(USE_CLOCK_DIGIT_TIMELINES)
+/*
+ * Plays the precomputed servo angles of the digit strokes with the ServoEasing timeline player.
+ * Assumes pen at upper position over origin of number. No inverse kinematics is computed.
+ */
+void playDigitTimeline(uint8_t aDigitPosition, uint8_t aNumber) {
+    doSetModeForClockMovement();
+    startTimeline(&ClockDigitTimelines[aDigitPosition][pgm_read_word(&ClockDigitTimelineIndex[aNumber])], false);
+    do {
+        if (delayAndCheckForRobotArm(REFRESH_INTERVAL_MILLIS)) {
+            stopTimeline();
+            stopAllServos();
+            return;
+        }
+    } while (!updateAllServos()); // updateAllServos() also starts the keyframes
+    // Set end position for the following goToPosition()
+    sEndPosition.LeftRight += (int8_t) pgm_read_byte(&ClockDigitEndOffset[aNumber][0]);
+    sEndPosition.BackFront += (int8_t) pgm_read_byte(&ClockDigitEndOffset[aNumber][1]);
+    sEndPosition.LeftRightDegree = BasePivotServo.getCurrentAngle();
+    sEndPosition.BackFrontDegree = HorizontalServo.getCurrentAngle();
+    sEndPosition.DownUpDegree = LiftServo.getCurrentAngle();
 }
+#endif
 
 void drawNumber(uint8_t aDigitPosition, uint8_t aNumber) {
 
@@ -377,6 +552,9 @@ void drawNumber(uint8_t aDigitPosition, uint8_t aNumber) {
     CLOCK_INFO_PRINT(F(" at "));
     CLOCK_INFO_PRINTLN(aDigitPosition);
 
+#if defined(USE_CLOCK_DIGIT_TIMELINES)
+    goToPosition(KEEP_POSITION, KEEP_POSITION, CLOCK_PEN_LIFTED_Z); // The timelines start with the pen lifted
+#endif
     switch (aDigitPosition) {
     case DIGIT_MINUTES_ONES:
         // go to lower left position of digit
@@ -394,7 +572,11 @@ void drawNumber(uint8_t aDigitPosition, uint8_t aNumber) {
     default:
         break;
     }
+#if defined(USE_CLOCK_DIGIT_TIMELINES)
+    playDigitTimeline(aDigitPosition, aNumber);
+#else
     drawNumber(aNumber);
+#endif
 }
 
 #if defined(LOCAL_INFO)
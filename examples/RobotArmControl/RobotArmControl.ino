@@ -32,10 +32,14 @@
 //#define ROBOT_ARM_HAS_RTC_CONTROL
 //#define ROBOT_ARM_1 // My black one
 //#define ROBOT_ARM_2 // My transparent one
+//#define USE_CARTESIAN_PATH_PLANNER // Draw the clock digits with continuous strokes instead of single moves, which start and stop at each corner
+//#define USE_CLOCK_DIGIT_TIMELINES // Draw the clock digits by playing precomputed servo angles from ClockDigitTimelines.h without any inverse kinematics
+//#define GENERATE_CLOCK_DIGIT_TIMELINES // Print new content for ClockDigitTimelines.h at startup instead of drawing
 
 #if defined(ROBOT_ARM_HAS_IR_CONTROL)
 #define USE_TINY_IR_RECEIVER // must be specified before including IRCommandDispatcher.hpp to define which IR library to use
 #define IR_INPUT_PIN  A0
+//#define ENABLE_IR_COMMAND_QUEUE // Queue commands received during a move and let the stop command end the move immediately
 #if defined(ROBOT_ARM_2)
 #define USE_CAR_MP3_REMOTE // Transparent arm
 #else
@@ -47,6 +51,9 @@
 
 #define ROBOT_ARM_INITIAL_SERVO_SPEED   80 // in degree/second or millimeter/second for inverse kinematic
 #include "RobotArmServoControl.hpp" // includes ServoEasing.hpp
+#if defined(USE_CARTESIAN_PATH_PLANNER)
+#include "RobotArmPathPlanner.hpp"
+#endif
 
 #if defined(ROBOT_ARM_HAS_RTC_CONTROL)
 //#define GERMAN_NAMES_FOR_DATE
@@ -122,6 +129,9 @@ void setup() {
 #endif
     // Just to know which program is running on my Arduino
     Serial.println(F("START " __FILE__ "\r\nVersion " VERSION_EXAMPLE " from " __DATE__));
+#if defined(GENERATE_CLOCK_DIGIT_TIMELINES)
+    printClockDigitTimelines(); // Copy this output to ClockDigitTimelines.h
+#endif
 
     /*
      * delay() to avoid uncontrolled servo moving after power on.
@@ -132,6 +142,9 @@ void setup() {
 
 #if defined(ROBOT_ARM_HAS_IR_CONTROL)
     IRDispatcher.init();
+#  if defined(ENABLE_IR_COMMAND_QUEUE)
+    IRDispatcher.setStopHandler(&stopAllServos); // End running moves directly at receiving the stop command
+#  endif
     Serial.print(F("Listening to IR remote of type "));
     Serial.print(IR_REMOTE_NAME);
     Serial.println(F(" at pin " STR(IR_INPUT_PIN)));
@@ -220,6 +220,160 @@ bool doInverseKinematics(struct ArmPosition *aPositionStruct) {
     return tReturnValue;
 }
 
+#if defined(USE_FIXED_POINT_KINEMATICS)
+/*
+ * Integer version of the inverse kinematics for the moves of the user easing function, which runs in the servo interrupt.
+ * Lengths are in 1/64 millimeter, angles in 1/100 degree.
+ * The angles are computed by the CORDIC algorithm, which requires only shifts and additions.
+ */
+#define KINEMATICS_LENGTH_SHIFT         6 // 1/64 millimeter
+#define CORDIC_ITERATIONS               14
+#define CORDIC_FRACTION_SHIFT           6 // Additional resolution for the iterations, which truncate at each shift
+#define CORDIC_GAIN_RECIPROCAL_Q15      19898 // 0.607253 * 32768
+
+const int16_t CordicArcTangentCentidegree[CORDIC_ITERATIONS] PROGMEM = { 4500, 2657, 1404, 713, 358, 179, 90, 45, 22, 11, 6, 3, 1, 1 };
+
+/*
+ * Integer version of cartesianToPolar()
+ * @param aXValue, aYValue in 1/64 millimeter, their absolute values must be smaller than 0x10000
+ * @param aRadius Radius in 1/64 millimeter
+ * @param aAngleCentidegree -18000 to 18000
+ */
+void cartesianToPolarFixedPoint(int32_t aXValue, int32_t aYValue, int32_t &aRadius, int32_t &aAngleCentidegree) {
+    // Like cartesianToPolar(), the angle of a zero vector is 0. The CORDIC would return -99 degree for it.
+    if (aXValue == 0 && aYValue == 0) {
+        aRadius = 0;
+        aAngleCentidegree = 0;
+        return;
+    }
+    int32_t tAngle = 0;
+    aXValue <<= CORDIC_FRACTION_SHIFT;
+    aYValue <<= CORDIC_FRACTION_SHIFT;
+    if (aXValue < 0) {
+        // rotate by 90 degree into the right half plane, where the CORDIC converges
+        int32_t tXValue = aXValue;
+        if (aYValue >= 0) {
+            aXValue = aYValue;
+            aYValue = -tXValue;
+            tAngle = 9000;
+        } else {
+            aXValue = -aYValue;
+            aYValue = tXValue;
+            tAngle = -9000;
+        }
+    }
+    for (uint_fast8_t i = 0; i < CORDIC_ITERATIONS; ++i) {
+        int32_t tXValue = aXValue;
+        int16_t tArcTangent = pgm_read_word(&CordicArcTangentCentidegree[i]);
+        if (aYValue > 0) {
+            aXValue += aYValue >> i;
+            aYValue -= tXValue >> i;
+            tAngle += tArcTangent;
+        } else {
+            aXValue -= aYValue >> i;
+            aYValue += tXValue >> i;
+            tAngle -= tArcTangent;
+        }
+    }
+    // Round, otherwise e.g. a radius of exactly CLAW_LENGTH_MILLIMETER is computed as too short
+    aRadius = (((int64_t) aXValue * CORDIC_GAIN_RECIPROCAL_Q15) + (1L << (14 + CORDIC_FRACTION_SHIFT))) >> (15 + CORDIC_FRACTION_SHIFT);
+    aAngleCentidegree = tAngle;
+}
+
+/*
+ * @return the largest integer, which square is not greater than aValue
+ */
+uint16_t integerSquareRootForKinematics(uint32_t aValue) {
+    uint32_t tRoot = 0;
+    uint32_t tBit = 1UL << 30;
+    while (tBit > aValue) {
+        tBit >>= 2;
+    }
+    while (tBit != 0) {
+        if (aValue >= tRoot + tBit) {
+            aValue -= tRoot + tBit;
+            tRoot = (tRoot >> 1) + tBit;
+        } else {
+            tRoot >>= 1;
+        }
+        tBit >>= 2;
+    }
+    return tRoot;
+}
+
+/**
+ * Integer version of getAngleOfTriangle() without acos() and division.
+ * The cosine rule loses all precision for angles near 0 and 180 degree, where the cosine is near 1 or -1.
+ * So the half angle formula tan(C/2) = sqrt((C-A+B)*(C+A-B)) / sqrt((A+B+C)*(A+B-C)) is used,
+ * whose factors are exact differences of the sides.
+ * @param aOppositeSide, aAdjacentSide1, aAdjacentSide2 in 1/64 millimeter
+ */
+bool getAngleOfTriangleFixedPoint(int32_t aOppositeSide, int32_t aAdjacentSide1, int32_t aAdjacentSide2, int32_t &aComputedAngleCentidegree) {
+    if (aAdjacentSide1 <= 0 || aAdjacentSide2 <= 0) {
+        return false;
+    }
+    int32_t tAdjacentSidesSum = aAdjacentSide1 + aAdjacentSide2;
+    int32_t tAdjacentSidesDifference = aAdjacentSide1 - aAdjacentSide2;
+    if (aOppositeSide > tAdjacentSidesSum || aOppositeSide < tAdjacentSidesDifference || aOppositeSide < -tAdjacentSidesDifference) {
+        return false; // no triangle
+    }
+    // All factors are positive and smaller than 2 * tAdjacentSidesSum, so the products fit into 32 bit
+    uint16_t tHalfAngleSinus = integerSquareRootForKinematics(
+            (uint32_t) (aOppositeSide - tAdjacentSidesDifference) * (uint32_t) (aOppositeSide + tAdjacentSidesDifference));
+    uint16_t tHalfAngleCosinus = integerSquareRootForKinematics(
+            (uint32_t) (tAdjacentSidesSum + aOppositeSide) * (uint32_t) (tAdjacentSidesSum - aOppositeSide));
+    int32_t tRadius; // not used
+    int32_t tHalfAngleCentidegree;
+    cartesianToPolarFixedPoint(tHalfAngleCosinus, tHalfAngleSinus, tRadius, tHalfAngleCentidegree);
+    aComputedAngleCentidegree = 2 * tHalfAngleCentidegree;
+    return true;
+}
+
+/**
+ * Integer version of doInverseKinematics() without any output, since it is called in the servo interrupt.
+ * @param aPositionStruct structure holding input position and output angles
+ * returns true if solving was successful, false if solving is not possible
+ */
+bool doInverseKinematicsFixedPoint(struct ArmPosition *aPositionStruct) {
+    bool tReturnValue = true;
+    int32_t tRadiusHorizontal, tHorizontalAngleCentidegree;
+    cartesianToPolarFixedPoint(aPositionStruct->LeftRight * (1 << KINEMATICS_LENGTH_SHIFT),
+            aPositionStruct->BackFront * (1 << KINEMATICS_LENGTH_SHIFT), tRadiusHorizontal, tHorizontalAngleCentidegree);
+    aPositionStruct->LeftRightDegree = (tHorizontalAngleCentidegree - 9000) / 100;
+
+    if (tRadiusHorizontal < (CLAW_LENGTH_MILLIMETER << KINEMATICS_LENGTH_SHIFT)) {
+        tRadiusHorizontal = 0; // fallback
+        tReturnValue = false;
+    } else {
+        tRadiusHorizontal -= (CLAW_LENGTH_MILLIMETER << KINEMATICS_LENGTH_SHIFT);
+    }
+
+    int32_t tVerticalAngleToClawCentidegree, tRadiusVertical;
+    cartesianToPolarFixedPoint(tRadiusHorizontal, aPositionStruct->DownUp * (1 << KINEMATICS_LENGTH_SHIFT), tRadiusVertical,
+            tVerticalAngleToClawCentidegree);
+    if (tRadiusVertical == 0) {
+        tRadiusVertical = 1; // The claw is nearer than the resolution to the shoulder, so take the limit of the angles
+    }
+
+    int32_t tAngleClawHorizontalCentidegree; // angle between vertical angle to claw and horizontal arm
+    if (!getAngleOfTriangleFixedPoint(LIFT_ARM_LENGTH_MILLIMETER << KINEMATICS_LENGTH_SHIFT,
+            HORIZONTAL_ARM_LENGTH_MILLIMETER << KINEMATICS_LENGTH_SHIFT, tRadiusVertical, tAngleClawHorizontalCentidegree)) {
+        return false;
+    }
+    int32_t tAngleHorizontalLiftCentidegree; // angle between horizontal and lift arm
+    if (!getAngleOfTriangleFixedPoint(tRadiusVertical, HORIZONTAL_ARM_LENGTH_MILLIMETER << KINEMATICS_LENGTH_SHIFT,
+            LIFT_ARM_LENGTH_MILLIMETER << KINEMATICS_LENGTH_SHIFT, tAngleHorizontalLiftCentidegree)) {
+        return false;
+    }
+
+    // See schematic at doInverseKinematics()
+    aPositionStruct->BackFrontDegree = (9000 - (tVerticalAngleToClawCentidegree + tAngleClawHorizontalCentidegree)) / 100;
+    aPositionStruct->DownUpDegree = (tVerticalAngleToClawCentidegree + tAngleClawHorizontalCentidegree + tAngleHorizontalLiftCentidegree
+            - 18000) / 100;
+    return tReturnValue;
+}
+#endif // defined(USE_FIXED_POINT_KINEMATICS)
+
 /*
  * Forward kinematics: servo angle -> X,Y,Z
  */
@@ -44,6 +44,9 @@ struct ArmPosition {
 void cartesianToPolar(float a, float b, float& r, float& theta);
 bool getAngleOfTriangle(float opp, float adj1, float adj2, float& theta);
 bool doInverseKinematics(struct ArmPosition * aPositionStruct);
+void cartesianToPolarFixedPoint(int32_t aXValue, int32_t aYValue, int32_t &aRadius, int32_t &aAngleCentidegree);
+bool getAngleOfTriangleFixedPoint(int32_t aOppositeSide, int32_t aAdjacentSide1, int32_t aAdjacentSide2, int32_t &aComputedAngleCentidegree);
+bool doInverseKinematicsFixedPoint(struct ArmPosition * aPositionStruct);
 
 /*
  * Forward kinematics: servo angle -> X,Y,Z
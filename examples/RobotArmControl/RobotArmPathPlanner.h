@@ -0,0 +1,65 @@
+/*
+ * RobotArmPathPlanner.h
+ *
+ * Queue of cartesian line and arc segments with lookahead, which are executed with continuous speed at the junctions.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _ROBOT_ARM_PATH_PLANNER_H
+#define _ROBOT_ARM_PATH_PLANNER_H
+
+#include <stdint.h>
+
+#if !defined(PATH_QUEUE_SIZE)
+#define PATH_QUEUE_SIZE                 4   // Number of segments used for lookahead. Each segment requires 36 bytes of RAM.
+#endif
+#if !defined(ROBOT_ARM_MAX_ACCELERATION)
+#define ROBOT_ARM_MAX_ACCELERATION      400 // in millimeter/(second * second)
+#endif
+#if !defined(JUNCTION_DEVIATION_MILLIMETER)
+#define JUNCTION_DEVIATION_MILLIMETER   0.5 // Allowed deviation from the corner at a junction. The higher, the faster corners are passed.
+#endif
+#if !defined(ARC_SEGMENT_MILLIMETER)
+#define ARC_SEGMENT_MILLIMETER          3   // Length of the line segments an arc is split into
+#endif
+
+struct PathSegment {
+    float StartPosition[3];     // LeftRight, BackFront, DownUp in millimeter
+    float UnitVector[3];
+    float Length;               // in millimeter
+    float MaximumEntrySpeed;    // in millimeter/second, limited by the angle between this and the previous segment
+    float EntrySpeed;           // in millimeter/second, computed by the lookahead
+};
+
+/*
+ * Values can be KEEP_POSITION. The speed is sRobotArmServoSpeed millimeter/second.
+ * All queue functions wait if the queue is full and return false if the position cannot be solved or a stop was requested.
+ */
+bool queueLineTo(int aLeftRightMillimeter, int aBackFrontMillimeter, int aDownUpMillimeter);
+bool queueLineRelative(int aLeftRightDeltaMillimeter, int aBackFrontDeltaMillimeter, int aDownUpDeltaMillimeter);
+bool queueArcTo(int aLeftRightMillimeter, int aBackFrontMillimeter, int aCenterOffsetLeftRightMillimeter,
+        int aCenterOffsetBackFrontMillimeter, bool aClockwise);
+
+bool updatePathPlanner(); // Must be called at least every REFRESH_INTERVAL_MILLIS. Returns true if all segments are done.
+bool waitForPathPlannerToStop();
+void clearPathPlanner();
+
+#endif // _ROBOT_ARM_PATH_PLANNER_H
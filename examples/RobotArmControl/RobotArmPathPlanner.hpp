@@ -0,0 +1,312 @@
+/*
+ * RobotArmPathPlanner.hpp
+ *
+ * Queue of cartesian line and arc segments with lookahead, which are executed with continuous speed at the junctions.
+ * Like a CNC planner, the speed at each junction is limited by the angle between the adjacent segments,
+ * and a backward and forward pass over the queue limits all speeds to what can be reached with ROBOT_ARM_MAX_ACCELERATION.
+ * The last queued segment always ends at speed 0, so new segments can be streamed while the arm is moving.
+ * The current position is computed each frame and fed to the inverse kinematics, which determines the 3 servo angles.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _ROBOT_ARM_PATH_PLANNER_HPP
+#define _ROBOT_ARM_PATH_PLANNER_HPP
+
+#include <Arduino.h>
+
+#include "RobotArmPathPlanner.h"
+#include "RobotArmServoControl.h"
+#include "RobotArmControl.h" // for delayAndCheckForRobotArm()
+
+PathSegment sPathQueue[PATH_QUEUE_SIZE];
+uint8_t sPathQueueFirstIndex;       // Index of the segment currently executed
+uint8_t sPathQueueNumberOfSegments; // Including the segment currently executed
+float sPathEndPosition[3];          // End position of the last queued segment
+float sPathDistanceInSegment;       // Distance traveled in the current segment
+float sPathSpeed;                   // Current speed in millimeter/second
+unsigned long sMillisOfLastPathUpdate;
+
+/*
+ * New segments start at the end of the last goToPosition() if the queue is empty
+ */
+void setPathStartPositionIfQueueEmpty() {
+    if (sPathQueueNumberOfSegments == 0) {
+        sPathEndPosition[0] = sEndPosition.LeftRight;
+        sPathEndPosition[1] = sEndPosition.BackFront;
+        sPathEndPosition[2] = sEndPosition.DownUp;
+    }
+}
+
+inline uint8_t getPathQueueIndex(uint8_t aOffset) {
+    return (sPathQueueFirstIndex + aOffset) % PATH_QUEUE_SIZE;
+}
+
+/*
+ * Speed at the end of a segment, if it starts with aEntrySpeed and is accelerated over its full length
+ */
+float getReachableSpeed(float aEntrySpeed, float aLength) {
+    return sqrt((aEntrySpeed * aEntrySpeed) + (2.0 * ROBOT_ARM_MAX_ACCELERATION * aLength));
+}
+
+/*
+ * Maximum speed at the junction of two segments, for which the arm deviates JUNCTION_DEVIATION_MILLIMETER
+ * from the corner if it follows a circle with centripetal acceleration ROBOT_ARM_MAX_ACCELERATION.
+ */
+float getJunctionSpeed(PathSegment *aPreviousSegment, PathSegment *aSegment) {
+    float tCosinusOfJunctionAngle = -((aPreviousSegment->UnitVector[0] * aSegment->UnitVector[0])
+            + (aPreviousSegment->UnitVector[1] * aSegment->UnitVector[1])
+            + (aPreviousSegment->UnitVector[2] * aSegment->UnitVector[2]));
+    if (tCosinusOfJunctionAngle > 0.999) {
+        return 0; // Reversal of direction
+    }
+    if (tCosinusOfJunctionAngle < -0.999) {
+        return sRobotArmServoSpeed; // Straight line
+    }
+    float tSinusOfHalfAngle = sqrt(0.5 * (1.0 - tCosinusOfJunctionAngle));
+    float tJunctionSpeed = sqrt(
+            ROBOT_ARM_MAX_ACCELERATION * JUNCTION_DEVIATION_MILLIMETER * tSinusOfHalfAngle / (1.0 - tSinusOfHalfAngle));
+    if (tJunctionSpeed > sRobotArmServoSpeed) {
+        return sRobotArmServoSpeed;
+    }
+    return tJunctionSpeed;
+}
+
+/*
+ * Backward pass from the last segment, which ends at speed 0, and forward pass from the current segment,
+ * which cannot be changed any more, since it is already executed.
+ */
+void recalculatePathSpeeds() {
+    uint8_t tLastOffset = sPathQueueNumberOfSegments - 1;
+    float tExitSpeed = 0;
+    for (int_fast8_t tOffset = tLastOffset; tOffset > 0; --tOffset) {
+        PathSegment *tSegment = &sPathQueue[getPathQueueIndex(tOffset)];
+        tSegment->EntrySpeed = getReachableSpeed(tExitSpeed, tSegment->Length);
+        if (tSegment->EntrySpeed > tSegment->MaximumEntrySpeed) {
+            tSegment->EntrySpeed = tSegment->MaximumEntrySpeed;
+        }
+        tExitSpeed = tSegment->EntrySpeed;
+    }
+
+    PathSegment *tCurrentSegment = &sPathQueue[sPathQueueFirstIndex];
+    float tEntrySpeed = getReachableSpeed(sPathSpeed, tCurrentSegment->Length - sPathDistanceInSegment);
+    for (uint_fast8_t tOffset = 1; tOffset <= tLastOffset; ++tOffset) {
+        PathSegment *tSegment = &sPathQueue[getPathQueueIndex(tOffset)];
+        if (tSegment->EntrySpeed > tEntrySpeed) {
+            tSegment->EntrySpeed = tEntrySpeed;
+        }
+        tEntrySpeed = getReachableSpeed(tSegment->EntrySpeed, tSegment->Length);
+    }
+}
+
+/*
+ * Appends a segment from sPathEndPosition to the new end position
+ */
+bool appendPathSegment(float aLeftRight, float aBackFront, float aDownUp) {
+    while (sPathQueueNumberOfSegments >= PATH_QUEUE_SIZE) {
+        if (delayAndCheckForRobotArm(REFRESH_INTERVAL_MILLIS)) {
+            clearPathPlanner();
+            return false;
+        }
+        updatePathPlanner();
+    }
+
+    if (sPathQueueNumberOfSegments == 0) {
+        // Start from rest
+        sPathDistanceInSegment = 0;
+        sPathSpeed = 0;
+        sMillisOfLastPathUpdate = millis();
+    }
+
+    PathSegment *tSegment = &sPathQueue[getPathQueueIndex(sPathQueueNumberOfSegments)];
+    float tDelta[3] = { aLeftRight - sPathEndPosition[0], aBackFront - sPathEndPosition[1], aDownUp - sPathEndPosition[2] };
+    float tLength = sqrt((tDelta[0] * tDelta[0]) + (tDelta[1] * tDelta[1]) + (tDelta[2] * tDelta[2]));
+    if (tLength < 0.1) {
+        return true; // Nothing to move
+    }
+    for (uint_fast8_t i = 0; i < 3; ++i) {
+        tSegment->StartPosition[i] = sPathEndPosition[i];
+        tSegment->UnitVector[i] = tDelta[i] / tLength;
+    }
+    tSegment->Length = tLength;
+    if (sPathQueueNumberOfSegments == 0) {
+        tSegment->MaximumEntrySpeed = 0;
+    } else {
+        tSegment->MaximumEntrySpeed = getJunctionSpeed(&sPathQueue[getPathQueueIndex(sPathQueueNumberOfSegments - 1)],
+                tSegment);
+    }
+    tSegment->EntrySpeed = 0;
+
+    sPathEndPosition[0] = aLeftRight;
+    sPathEndPosition[1] = aBackFront;
+    sPathEndPosition[2] = aDownUp;
+    sPathQueueNumberOfSegments++;
+    recalculatePathSpeeds();
+    return true;
+}
+
+/*
+ * Checks the end position with the float inverse kinematics, which prints a message if it cannot be solved
+ */
+bool queueLineTo(int aLeftRightMillimeter, int aBackFrontMillimeter, int aDownUpMillimeter) {
+    setPathStartPositionIfQueueEmpty();
+    struct ArmPosition tEndPosition;
+    tEndPosition.LeftRight = (aLeftRightMillimeter == KEEP_POSITION) ? sPathEndPosition[0] : aLeftRightMillimeter;
+    tEndPosition.BackFront = (aBackFrontMillimeter == KEEP_POSITION) ? sPathEndPosition[1] : aBackFrontMillimeter;
+    tEndPosition.DownUp = (aDownUpMillimeter == KEEP_POSITION) ? sPathEndPosition[2] : aDownUpMillimeter;
+    if (!doInverseKinematics(&tEndPosition)) {
+        Serial.print(F("This end position cannot be solved: "));
+        printPosition(&tEndPosition);
+        return false;
+    }
+    return appendPathSegment(tEndPosition.LeftRight, tEndPosition.BackFront, tEndPosition.DownUp);
+}
+
+bool queueLineRelative(int aLeftRightDeltaMillimeter, int aBackFrontDeltaMillimeter, int aDownUpDeltaMillimeter) {
+    setPathStartPositionIfQueueEmpty();
+    return queueLineTo(sPathEndPosition[0] + aLeftRightDeltaMillimeter, sPathEndPosition[1] + aBackFrontDeltaMillimeter,
+            sPathEndPosition[2] + aDownUpDeltaMillimeter);
+}
+
+/*
+ * Arc in the horizontal plane at the current height, like G-code G2 / G3.
+ * The center is given relative to the current position. The arc is split into lines of ARC_SEGMENT_MILLIMETER.
+ */
+bool queueArcTo(int aLeftRightMillimeter, int aBackFrontMillimeter, int aCenterOffsetLeftRightMillimeter,
+        int aCenterOffsetBackFrontMillimeter, bool aClockwise) {
+    setPathStartPositionIfQueueEmpty();
+    float tCenterLeftRight = sPathEndPosition[0] + aCenterOffsetLeftRightMillimeter;
+    float tCenterBackFront = sPathEndPosition[1] + aCenterOffsetBackFrontMillimeter;
+    float tRadius = sqrt(
+            ((float) aCenterOffsetLeftRightMillimeter * aCenterOffsetLeftRightMillimeter)
+                    + ((float) aCenterOffsetBackFrontMillimeter * aCenterOffsetBackFrontMillimeter));
+    float tStartAngle = atan2(-aCenterOffsetBackFrontMillimeter, -aCenterOffsetLeftRightMillimeter);
+    float tSweepAngle = atan2(aBackFrontMillimeter - tCenterBackFront, aLeftRightMillimeter - tCenterLeftRight) - tStartAngle;
+    if (aClockwise && tSweepAngle >= 0) {
+        tSweepAngle -= 2 * PI;
+    } else if (!aClockwise && tSweepAngle <= 0) {
+        tSweepAngle += 2 * PI;
+    }
+
+    uint16_t tNumberOfSegments = (fabs(tSweepAngle) * tRadius) / ARC_SEGMENT_MILLIMETER;
+    float tDownUp = sPathEndPosition[2];
+    for (uint16_t i = 1; i < tNumberOfSegments; ++i) {
+        float tAngle = tStartAngle + ((tSweepAngle * i) / tNumberOfSegments);
+        if (!appendPathSegment(tCenterLeftRight + (tRadius * cos(tAngle)), tCenterBackFront + (tRadius * sin(tAngle)), tDownUp)) {
+            return false;
+        }
+    }
+    return queueLineTo(aLeftRightMillimeter, aBackFrontMillimeter, KEEP_POSITION);
+}
+
+/*
+ * Advances the position along the queued segments and writes the servo angles computed by the inverse kinematics.
+ * The speed is increased with ROBOT_ARM_MAX_ACCELERATION up to sRobotArmServoSpeed and
+ * decreased early enough to reach the entry speed of the next segment.
+ * @return true if all segments are done
+ */
+bool updatePathPlanner() {
+    if (sPathQueueNumberOfSegments == 0) {
+        return true;
+    }
+    unsigned long tMillis = millis();
+    unsigned long tMillisSinceLastUpdate = tMillis - sMillisOfLastPathUpdate;
+    if (tMillisSinceLastUpdate < REFRESH_INTERVAL_MILLIS) {
+        return false;
+    }
+    sMillisOfLastPathUpdate = tMillis;
+    float tSeconds = tMillisSinceLastUpdate / 1000.0;
+
+    PathSegment *tSegment = &sPathQueue[sPathQueueFirstIndex];
+    float tExitSpeed = 0;
+    if (sPathQueueNumberOfSegments > 1) {
+        tExitSpeed = sPathQueue[getPathQueueIndex(1)].EntrySpeed;
+    }
+    sPathSpeed += ROBOT_ARM_MAX_ACCELERATION * tSeconds;
+    if (sPathSpeed > sRobotArmServoSpeed) {
+        sPathSpeed = sRobotArmServoSpeed;
+    }
+    float tMaximumSpeed = getReachableSpeed(tExitSpeed, tSegment->Length - sPathDistanceInSegment);
+    if (sPathSpeed > tMaximumSpeed) {
+        sPathSpeed = tMaximumSpeed;
+    }
+    sPathDistanceInSegment += sPathSpeed * tSeconds;
+
+    // Continue with the next segment(s)
+    while (sPathDistanceInSegment >= tSegment->Length) {
+        if (sPathQueueNumberOfSegments == 1) {
+            sPathDistanceInSegment = tSegment->Length;
+            break;
+        }
+        sPathDistanceInSegment -= tSegment->Length;
+        sPathQueueFirstIndex = getPathQueueIndex(1);
+        sPathQueueNumberOfSegments--;
+        tSegment = &sPathQueue[sPathQueueFirstIndex];
+    }
+
+    sCurrentPosition.LeftRight = tSegment->StartPosition[0] + (tSegment->UnitVector[0] * sPathDistanceInSegment);
+    sCurrentPosition.BackFront = tSegment->StartPosition[1] + (tSegment->UnitVector[1] * sPathDistanceInSegment);
+    sCurrentPosition.DownUp = tSegment->StartPosition[2] + (tSegment->UnitVector[2] * sPathDistanceInSegment);
+#if defined(USE_FIXED_POINT_KINEMATICS)
+    bool tSolved = doInverseKinematicsFixedPoint(&sCurrentPosition);
+#else
+    bool tSolved = doInverseKinematics(&sCurrentPosition);
+#endif
+    if (tSolved) {
+        BasePivotServo.write(sCurrentPosition.LeftRightDegree);
+        HorizontalServo.write(sCurrentPosition.BackFrontDegree);
+        LiftServo.write(sCurrentPosition.DownUpDegree);
+    }
+
+    if (sPathQueueNumberOfSegments == 1 && sPathDistanceInSegment >= tSegment->Length) {
+        // Last segment is done, now goToPosition() can continue from here
+        sPathQueueNumberOfSegments = 0;
+        sPathSpeed = 0;
+        sEndPosition = sCurrentPosition;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * @return false if stop was requested
+ */
+bool waitForPathPlannerToStop() {
+    while (!updatePathPlanner()) {
+        if (delayAndCheckForRobotArm(REFRESH_INTERVAL_MILLIS)) {
+            clearPathPlanner();
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Stops at the current position
+ */
+void clearPathPlanner() {
+    if (sPathQueueNumberOfSegments != 0) {
+        sPathQueueNumberOfSegments = 0;
+        sPathSpeed = 0;
+        sEndPosition = sCurrentPosition;
+    }
+}
+
+#endif // _ROBOT_ARM_PATH_PLANNER_HPP
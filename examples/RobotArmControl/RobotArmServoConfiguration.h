@@ -37,6 +37,9 @@
 #define MAX_EASING_SERVOS 4
 //#define DISABLE_MICROS_AS_DEGREE_PARAMETER // Activating this disables microsecond values as (target angle) parameter. Saves 128 bytes program memory.
 //#define DEBUG                         // Activate this to generate lots of lovely debug output for this library.
+#if defined(USE_CLOCK_DIGIT_TIMELINES)
+#define ENABLE_TIMELINE_PLAYER        // Plays the precomputed servo angles of the clock digits
+#endif
 
 /*
  * Specify which easings types should be available.
@@ -77,6 +80,12 @@
 #define HORIZONTAL_NEUTRAL_MILLIMETER          LIFT_ARM_LENGTH_MILLIMETER + CLAW_LENGTH_MILLIMETER
 #define VERTICAL_NEUTRAL_MILLIMETER            HORIZONTAL_ARM_LENGTH_MILLIMETER
 
+/*
+ * Activate this to compute the inverse kinematics of all frames of a move with integer CORDIC arithmetic instead of float acos() and sqrt().
+ * This avoids the float library functions in the 20 ms servo interrupt on CPUs without FPU. The angles may differ by 1 degree.
+ */
+//#define USE_FIXED_POINT_KINEMATICS
+
 // Index into (external) servo array. Order must be the same as of definitions in main.
 #define SERVO_BASE_PIVOT    0
 #define SERVO_HORIZONTAL    1
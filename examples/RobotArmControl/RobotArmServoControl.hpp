@@ -256,7 +256,11 @@ void computeNewCurrentAngles(float aPercentageOfCompletion) {
     sCurrentPosition.LeftRight = sStartPosition.LeftRight + (sPositionDelta.LeftRight * aPercentageOfCompletion);
     sCurrentPosition.BackFront = sStartPosition.BackFront + (sPositionDelta.BackFront * aPercentageOfCompletion);
     sCurrentPosition.DownUp = sStartPosition.DownUp + (sPositionDelta.DownUp * aPercentageOfCompletion);
+#if defined(USE_FIXED_POINT_KINEMATICS)
+    doInverseKinematicsFixedPoint(&sCurrentPosition); // No float trigonometric functions and no output in interrupt
+#else
     doInverseKinematics(&sCurrentPosition);
+#endif
 #if defined(LOCAL_TRACE)
     Serial.print("Current: ");
     Serial.print(aPercentageOfCompletion);
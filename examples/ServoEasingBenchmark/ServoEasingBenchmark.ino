@@ -0,0 +1,289 @@
+/*
+ * ServoEasingBenchmark.cpp
+ *
+ * Measures the CPU time used by the library on your board, not the speed of your servo.
+ * Times update() for each easing type, _writeMicrosecondsOrUnits() of the selected servo backend
+ * and a complete updateAllServos() frame for 1, 8, 16 and 32 servos.
+ * The servo backend is selected by the macros below, so compile it once for each backend you want to compare.
+ *
+ * Output is a table with one result per line, separated by semicolon, for easy import into a spreadsheet:
+ * Benchmark;Variant;Servos;Cycles;Microseconds
+ * The cycles are taken from the DWT cycle counter on ARM Cortex-M3 and higher, from ESP.getCycleCount() on ESP8266 and ESP32
+ * and are computed from micros() on all other platforms.
+ * On AVR, Timer1 is used by the Servo library and the ServoEasing interrupt, so we use micros() and average over many calls.
+ *
+ * Compare the microseconds of the updateAllServos() frame with REFRESH_INTERVAL_MICROS (20000)
+ * to see if your board can move this number of servos with interrupts.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#include <Arduino.h>
+
+// Must specify this before the include of "ServoEasing.hpp"
+//#define USE_PCA9685_SERVO_EXPANDER    // Activating this enables the use of the PCA9685 I2C expander chip/board.
+//#define USE_SOFT_I2C_MASTER           // Saves 1756 bytes program memory and 218 bytes RAM compared with Arduino Wire
+//#define USE_LEIGHTWEIGHT_SERVO_LIB    // Makes the servo pulse generating immune to other libraries blocking interrupts for a longer time like SoftwareSerial, Adafruit_NeoPixel and DmxSimple.
+//#define ENABLE_PCA9685_FRAME_COMMIT   // Send all PCA9685 channels changed by updateAllServos() with one I2C transmission per run of changed channels.
+//#define USE_FIXED_POINT_EASING        // Compare the integer with the float easing functions.
+//#define USE_EASING_LOOKUP_TABLES      // Compare the table lookup with the sin(), sqrt() and pow() easing functions.
+//#define ENABLE_PACKED_UPDATE_KERNEL   // Compare the frame times of the packed kernel for linear movements.
+//#define PROVIDE_ONLY_LINEAR_MOVEMENT  // Activating this disables all but LINEAR movement. Saves up to 1540 bytes program memory.
+//#define DISABLE_COMPLEX_FUNCTIONS     // Activating this disables the SINE, CIRCULAR, BACK, ELASTIC, BOUNCE and PRECISION easings. Saves up to 1850 bytes program memory.
+#if !defined(MAX_EASING_SERVOS)
+#  if defined(__AVR__) && !defined(USE_PCA9685_SERVO_EXPANDER)
+#define MAX_EASING_SERVOS 8 // The Arduino Servo library supports only 12 servos for one timer
+#  elif defined(__AVR__) && (RAMEND <= 0x8FF)
+#define MAX_EASING_SERVOS 16 // 2 kByte RAM is not sufficient for 32 servo objects
+#  else
+#define MAX_EASING_SERVOS 32
+#  endif
+#endif
+#include "ServoEasing.hpp"
+#include "PinDefinitionsAndMore.h"
+
+#define NUMBER_OF_CALLS_PER_MEASUREMENT 100
+
+/*
+ * Cycle counter for each platform
+ */
+#if defined(ESP8266) || defined(ESP32)
+#define getCycleCount()         ESP.getCycleCount()
+#define CYCLES_PER_MICROSECOND  ESP.getCpuFreqMHz()
+#define CYCLE_SOURCE            F("ESP.getCycleCount()")
+
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) // Cortex-M3, M4, M7. Cortex-M0+ like SAMD21 and RP2040 have no DWT cycle counter.
+#define DEMCR                   (*(volatile uint32_t*) 0xE000EDFC) // Debug Exception and Monitor Control Register
+#define DEMCR_TRCENA            (1 << 24)
+#define DWT_CTRL                (*(volatile uint32_t*) 0xE0001000)
+#define DWT_CTRL_CYCCNTENA      (1 << 0)
+#define DWT_CYCCNT              (*(volatile uint32_t*) 0xE0001004)
+#define USE_DWT_CYCLE_COUNTER
+#define getCycleCount()         DWT_CYCCNT
+#define CYCLES_PER_MICROSECOND  (F_CPU / 1000000L)
+#define CYCLE_SOURCE            F("DWT cycle counter")
+
+#else
+#define getCycleCount()         (micros() * CYCLES_PER_MICROSECOND)
+#  if defined(F_CPU)
+#define CYCLES_PER_MICROSECOND  (F_CPU / 1000000L)
+#  else
+#define CYCLES_PER_MICROSECOND  1 // We do not know the CPU clock, so print microseconds as cycles
+#  endif
+#define CYCLE_SOURCE            F("micros()")
+#endif
+
+#if defined(USE_PCA9685_SERVO_EXPANDER)
+#  if defined(USE_SOFT_I2C_MASTER)
+#define SERVO_BACKEND           F("PCA9685_SoftI2CMaster")
+#  else
+#define SERVO_BACKEND           F("PCA9685_Wire")
+#  endif
+#elif defined(USE_LEIGHTWEIGHT_SERVO_LIB)
+#define SERVO_BACKEND           F("LightweightServo")
+#else
+#define SERVO_BACKEND           F("Servo")
+#endif
+
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+const uint8_t EasingTypesToMeasure[] = { EASE_LINEAR, EASE_QUADRATIC_IN_OUT, EASE_CUBIC_IN_OUT, EASE_QUARTIC_IN_OUT,
+#  if !defined(DISABLE_COMPLEX_FUNCTIONS)
+        EASE_SINE_IN_OUT, EASE_CIRCULAR_IN_OUT, EASE_BACK_IN_OUT, EASE_ELASTIC_IN_OUT, EASE_BOUNCE_OUT, EASE_PRECISION_OUT,
+#  endif
+        EASE_QUADRATIC_IN, EASE_QUADRATIC_OUT, EASE_QUADRATIC_BOUNCING };
+#endif
+const uint8_t NumberOfServosToMeasure[] = { 1, 8, 16, 32 };
+
+ServoEasing *sServos[MAX_EASING_SERVOS];
+uint8_t sNumberOfAttachedServos = 0;
+
+void attachServos(uint8_t aNumberOfServos);
+void printResult(const __FlashStringHelper *aBenchmark, uint8_t aEasingType, uint8_t aNumberOfServos, uint32_t aCycles,
+        const __FlashStringHelper *aVariant = NULL);
+void measureUpdate();
+void measureWrite();
+void measureFrame();
+
+void setup() {
+    pinMode(LED_BUILTIN, OUTPUT);
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/|| defined(SERIALUSB_PID) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_SERVO_EASING));
+
+#if defined(USE_DWT_CYCLE_COUNTER)
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+
+    Serial.print(F("Backend="));
+    Serial.print(SERVO_BACKEND);
+    Serial.print(F(" cycle source="));
+    Serial.print(CYCLE_SOURCE);
+    Serial.print(F(" cycles per microsecond="));
+    Serial.println(CYCLES_PER_MICROSECOND);
+    Serial.println();
+
+    Serial.println(F("Benchmark;Variant;Servos;Cycles;Microseconds"));
+    measureUpdate();
+    measureWrite();
+    measureFrame();
+    Serial.println(F("Benchmark finished"));
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, HIGH);
+    delay(100);
+    digitalWrite(LED_BUILTIN, LOW);
+    delay(900);
+}
+
+/*
+ * Attach servos until aNumberOfServos are attached.
+ * For PCA9685 we use 16 channels of each board starting at PCA9685_DEFAULT_ADDRESS, otherwise all servos share SERVO1_PIN.
+ */
+void attachServos(uint8_t aNumberOfServos) {
+    while (sNumberOfAttachedServos < aNumberOfServos) {
+#if defined(USE_PCA9685_SERVO_EXPANDER)
+        ServoEasing *tServo = new ServoEasing(PCA9685_DEFAULT_ADDRESS + (sNumberOfAttachedServos / PCA9685_MAX_CHANNELS));
+        tServo->attach(sNumberOfAttachedServos % PCA9685_MAX_CHANNELS, 90);
+#else
+        ServoEasing *tServo = new ServoEasing();
+        tServo->attach(SERVO1_PIN, 90);
+#endif
+        sServos[sNumberOfAttachedServos++] = tServo;
+    }
+}
+
+/*
+ * @param aVariant - If NULL, the name of the easing type is printed as variant
+ */
+void printResult(const __FlashStringHelper *aBenchmark, uint8_t aEasingType, uint8_t aNumberOfServos, uint32_t aCycles,
+        const __FlashStringHelper *aVariant) {
+    Serial.print(aBenchmark);
+    Serial.print(';');
+    if (aVariant != NULL) {
+        Serial.print(aVariant);
+    } else {
+#if defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+        (void) aEasingType;
+        Serial.print(F("linear"));
+#else
+        ServoEasing::printEasingType(&Serial, aEasingType);
+#endif
+    }
+    Serial.print(';');
+    Serial.print(aNumberOfServos);
+    Serial.print(';');
+    Serial.print(aCycles);
+    Serial.print(';');
+    Serial.println((float) aCycles / CYCLES_PER_MICROSECOND, 2);
+}
+
+/*
+ * Time of one update() of one servo, which is in the middle of a move, for each easing type.
+ * Each call is at a new time and the easing type is set before the move, so nothing is cached.
+ */
+void measureUpdate() {
+    attachServos(1);
+    ServoEasing *tServo = sServos[0];
+#if defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+    const uint8_t tNumberOfEasingTypes = 1;
+#else
+    const uint8_t tNumberOfEasingTypes = sizeof(EasingTypesToMeasure);
+#endif
+    for (uint_fast8_t i = 0; i < tNumberOfEasingTypes; ++i) {
+#if defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+        uint8_t tEasingType = 0;
+#else
+        uint8_t tEasingType = EasingTypesToMeasure[i];
+        tServo->setEasingType(tEasingType);
+#endif
+        tServo->write(0);
+        tServo->startEaseToD(180, 10000, DO_NOT_START_UPDATE_BY_INTERRUPT);
+        uint32_t tNow = getServoEasingTime();
+        uint32_t tStartCycles = getCycleCount();
+        for (uint_fast8_t j = 0; j < NUMBER_OF_CALLS_PER_MEASUREMENT; ++j) {
+            tServo->update(tNow);
+            tNow += SERVO_EASING_TIME_UNITS_PER_MILLISECOND * 40; // 100 calls cover 4 of the 10 seconds
+        }
+        uint32_t tCycles = getCycleCount() - tStartCycles;
+        tServo->stop();
+        printResult(F("update"), tEasingType, 1, tCycles / NUMBER_OF_CALLS_PER_MEASUREMENT);
+    }
+}
+
+/*
+ * Time of one _writeMicrosecondsOrUnits() with the selected backend, i.e. the cost of sending one value to the servo.
+ * The values alternate, to avoid any suppression of unchanged values.
+ */
+void measureWrite() {
+    ServoEasing *tServo = sServos[0];
+    int tMicrosecondsOrUnits = tServo->DegreeOrMicrosecondToMicrosecondsOrUnits(90);
+    uint32_t tStartCycles = getCycleCount();
+    for (uint_fast8_t j = 0; j < NUMBER_OF_CALLS_PER_MEASUREMENT; ++j) {
+        tServo->_writeMicrosecondsOrUnits(tMicrosecondsOrUnits + (j & 0x01));
+    }
+    uint32_t tCycles = getCycleCount() - tStartCycles;
+    printResult(F("write"), 0, 1, tCycles / NUMBER_OF_CALLS_PER_MEASUREMENT, SERVO_BACKEND);
+}
+
+/*
+ * Time of one complete updateAllServos() frame, with all servos moving with EASE_LINEAR and EASE_CUBIC_IN_OUT.
+ * This is what the servo interrupt does every REFRESH_INTERVAL_MICROS.
+ */
+void measureFrame() {
+    for (uint_fast8_t i = 0; i < sizeof(NumberOfServosToMeasure); ++i) {
+        uint8_t tNumberOfServos = NumberOfServosToMeasure[i];
+        if (tNumberOfServos > MAX_EASING_SERVOS) {
+            break;
+        }
+        attachServos(tNumberOfServos);
+#if defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+        const uint8_t tNumberOfEasingTypes = 1;
+#else
+        const uint8_t tNumberOfEasingTypes = 2;
+#endif
+        for (uint_fast8_t k = 0; k < tNumberOfEasingTypes; ++k) {
+            uint8_t tEasingType = (k == 0) ? EASE_LINEAR : EASE_CUBIC_IN_OUT;
+            for (uint_fast8_t j = 0; j < tNumberOfServos; ++j) {
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+                sServos[j]->setEasingType(tEasingType);
+#endif
+                sServos[j]->write(0);
+                sServos[j]->startEaseToD(180, 10000, DO_NOT_START_UPDATE_BY_INTERRUPT);
+            }
+            /*
+             * Measure 10 frames, each 20 ms apart, so each frame computes new values for all servos
+             */
+            uint32_t tCycles = 0;
+            for (uint_fast8_t j = 0; j < 10; ++j) {
+                delay(REFRESH_INTERVAL_MILLIS);
+                uint32_t tStartCycles = getCycleCount();
+                updateAllServos();
+                tCycles += getCycleCount() - tStartCycles;
+            }
+            stopAllServos();
+            printResult(F("updateAllServos"), tEasingType, tNumberOfServos, tCycles / 10);
+        }
+    }
+}
@@ -140,6 +140,27 @@ uint16_t getVoltageMillivolt(uint8_t aADCChannelForVoltageMeasurement);
 uint16_t getVoltageMillivoltWith_1_1VoltReference(uint8_t aADCChannelForVoltageMeasurement);
 float getTemperature(void);
 
+/*
+ * If ENABLE_ADC_BACKGROUND_SAMPLING is defined, up to ADC_BACKGROUND_MAX_CHANNELS channels are sampled round robin by the ADC interrupt.
+ * Each channel is oversampled with its own exponent and the average is stored only if all samples are taken,
+ * so getADCBackgroundValue() always returns a complete and fresh value without blocking.
+ * Samples taken directly after a channel or reference switch are discarded.
+ * Call stopADCBackgroundSampling() before using the blocking read functions.
+ */
+//#define ENABLE_ADC_BACKGROUND_SAMPLING
+#if defined(ENABLE_ADC_BACKGROUND_SAMPLING)
+#if !defined(ADC_BACKGROUND_MAX_CHANNELS)
+#define ADC_BACKGROUND_MAX_CHANNELS 4
+#endif
+#define ADC_BACKGROUND_MAX_OVERSAMPLE_EXPONENT  6 // 64 * 1023 fits into 16 bit
+
+uint8_t addADCBackgroundChannel(uint8_t aChannelNumber, uint8_t aReference, uint8_t aOversampleExponent);
+void startADCBackgroundSampling();
+void stopADCBackgroundSampling();
+uint16_t getADCBackgroundValue(uint8_t aIndex);
+uint16_t getADCBackgroundNumberOfRounds();
+#endif
+
 #endif // defined(ADATE)
 #endif //  defined(__AVR__)
 #endif // _ADC_UTILS_H
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+#
+# DecodeServoEasingTelemetry.py
+#
+# Decodes the binary records sent by writeTelemetryRecords() of ServoEasing compiled with ENABLE_TELEMETRY_BUFFER.
+# Reads from a serial port or a file with the captured bytes and prints one line per record:
+# frame  servo  value  flags
+#
+# Usage: DecodeServoEasingTelemetry.py /dev/ttyUSB0 [baudrate]   (requires pyserial)
+#        DecodeServoEasingTelemetry.py capture.bin
+#
+#  Copyright (C) 2022  Armin Joachimsmeyer
+#  armin.joachimsmeyer@gmail.com
+#
+#  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+#
+#  ServoEasing is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import os
+import struct
+import sys
+
+TELEMETRY_RECORD_SYNC_BYTE = 0xA5
+TELEMETRY_RECORD_LENGTH = 7
+TELEMETRY_FLAG_MOVING = 0x01
+TELEMETRY_FLAG_CONSTRAINED = 0x02
+TELEMETRY_FLAG_RECORDS_LOST = 0x80
+
+
+def flagsToString(aFlags):
+    tString = ''
+    tString += 'M' if aFlags & TELEMETRY_FLAG_MOVING else '-'
+    tString += 'C' if aFlags & TELEMETRY_FLAG_CONSTRAINED else '-'
+    tString += 'L' if aFlags & TELEMETRY_FLAG_RECORDS_LOST else '-'
+    return tString
+
+
+def decode(aInput):
+    tBuffer = bytearray()
+    tLastFrameNumber = None
+    while True:
+        tBytes = aInput.read(64)
+        if not tBytes:
+            if not hasattr(aInput, 'in_waiting'):
+                break  # end of file
+            continue  # serial timeout
+        tBuffer += tBytes
+        while len(tBuffer) >= TELEMETRY_RECORD_LENGTH:
+            if tBuffer[0] != TELEMETRY_RECORD_SYNC_BYTE:
+                del tBuffer[0]  # resynchronize, e.g. after text output or start in the middle of a record
+                continue
+            tFrameNumber, tServoIndex, tFlags, tValue = struct.unpack('<HBBh', tBuffer[1:TELEMETRY_RECORD_LENGTH])
+            del tBuffer[:TELEMETRY_RECORD_LENGTH]
+            if tLastFrameNumber is not None and tFrameNumber != tLastFrameNumber and tFrameNumber != ((tLastFrameNumber + 1) & 0xFFFF):
+                print('# {} frames without writes'.format((tFrameNumber - tLastFrameNumber - 1) & 0xFFFF))
+            tLastFrameNumber = tFrameNumber
+            print('{:5d} {:3d} {:5d} {}'.format(tFrameNumber, tServoIndex, tValue, flagsToString(tFlags)))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('Usage: {} <serial port or file> [baudrate]'.format(sys.argv[0]))
+        sys.exit(1)
+    if os.path.isfile(sys.argv[1]):
+        with open(sys.argv[1], 'rb') as tFile:
+            decode(tFile)
+    else:
+        import serial
+        tBaudrate = int(sys.argv[2]) if len(sys.argv) > 2 else 115200
+        with serial.Serial(sys.argv[1], tBaudrate, timeout=1) as tSerial:
+            decode(tSerial)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
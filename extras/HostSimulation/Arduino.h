@@ -0,0 +1,184 @@
+/*
+ * Arduino.h
+ *
+ * Minimal Arduino API for compiling ServoEasing with ENABLE_SIMULATION_MODE on the host, e.g. Linux or Windows with g++.
+ * Only the functions required by ServoEasing and by simple motion sequences are provided.
+ * millis(), micros() and delay() must be implemented by the simulation program, see ServoEasingHostSimulation.cpp.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _HOST_SIMULATION_ARDUINO_H
+#define _HOST_SIMULATION_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Program memory is regular memory on the host
+#define PROGMEM
+#define F(aString) (reinterpret_cast<const __FlashStringHelper *>(aString))
+#define pgm_read_byte(aAddress)  (*(const uint8_t *)(aAddress))
+#define pgm_read_word(aAddress)  (*(const uint16_t *)(aAddress))
+#define pgm_read_dword(aAddress) (*(const uint32_t *)(aAddress))
+#define pgm_read_float(aAddress) (*(const float *)(aAddress))
+#define pgm_read_ptr(aAddress)   (*(void * const *)(aAddress))
+#define memcpy_P memcpy
+class __FlashStringHelper;
+
+#define DEC 10
+#define HEX 16
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LED_BUILTIN 13
+
+#define constrain(aValue, aLow, aHigh) ((aValue) < (aLow) ? (aLow) : ((aValue) > (aHigh) ? (aHigh) : (aValue)))
+using ::abs;
+typedef bool boolean;
+typedef uint8_t byte;
+
+/*
+ * To be implemented by the simulation program, in order to use the virtual clock
+ */
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long aMillis);
+
+inline void delayMicroseconds(unsigned int aMicros __attribute__((unused))) {
+}
+inline void yield() {
+}
+inline void interrupts() {
+}
+inline void noInterrupts() {
+}
+inline void pinMode(uint8_t aPin __attribute__((unused)), uint8_t aMode __attribute__((unused))) {
+}
+inline void digitalWrite(uint8_t aPin __attribute__((unused)), uint8_t aValue __attribute__((unused))) {
+}
+inline int digitalRead(uint8_t aPin __attribute__((unused))) {
+    return LOW;
+}
+inline long map(long aValue, long aFromLow, long aFromHigh, long aToLow, long aToHigh) {
+    return (aValue - aFromLow) * (aToHigh - aToLow) / (aFromHigh - aFromLow) + aToLow;
+}
+
+/*
+ * All print functions are based on write(uint8_t), so a subclass only has to implement this function,
+ * e.g. to write the trace to a file
+ */
+class Print {
+public:
+    virtual ~Print() {
+    }
+    virtual size_t write(uint8_t aByte) = 0;
+    size_t write(const uint8_t *aBuffer, size_t aSize) {
+        size_t tLength = 0;
+        while (aSize-- > 0) {
+            tLength += write(*aBuffer++);
+        }
+        return tLength;
+    }
+    size_t write(const char *aString) {
+        size_t tLength = 0;
+        while (*aString != '\0') {
+            tLength += write((uint8_t) *aString++);
+        }
+        return tLength;
+    }
+    size_t print(const __FlashStringHelper *aString) {
+        return write(reinterpret_cast<const char *>(aString));
+    }
+    size_t print(const char *aString) {
+        return write(aString);
+    }
+    size_t print(char aChar) {
+        return write((uint8_t) aChar);
+    }
+    size_t print(long aValue, int aBase = DEC) {
+        char tBuffer[24];
+        snprintf(tBuffer, sizeof(tBuffer), (aBase == HEX) ? "%lX" : "%ld", aValue);
+        return write(tBuffer);
+    }
+    size_t print(unsigned long aValue, int aBase = DEC) {
+        char tBuffer[24];
+        snprintf(tBuffer, sizeof(tBuffer), (aBase == HEX) ? "%lX" : "%lu", aValue);
+        return write(tBuffer);
+    }
+    size_t print(int aValue, int aBase = DEC) {
+        return print((long) aValue, aBase);
+    }
+    size_t print(unsigned int aValue, int aBase = DEC) {
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(unsigned char aValue, int aBase = DEC) {
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(double aValue, int aDigits = 2) {
+        char tBuffer[32];
+        snprintf(tBuffer, sizeof(tBuffer), "%.*f", aDigits, aValue);
+        return write(tBuffer);
+    }
+    size_t println() {
+        return write("\r\n");
+    }
+    template<typename T> size_t println(T aValue) {
+        size_t tLength = print(aValue);
+        return tLength + println();
+    }
+    template<typename T> size_t println(T aValue, int aBaseOrDigits) {
+        size_t tLength = print(aValue, aBaseOrDigits);
+        return tLength + println();
+    }
+    void flush() {
+    }
+};
+
+class Stream: public Print {
+public:
+    int available() {
+        return 0;
+    }
+    int read() {
+        return -1;
+    }
+};
+
+/*
+ * Serial writes to stdout
+ */
+class HardwareSerial: public Stream {
+public:
+    void begin(unsigned long aBaudrate __attribute__((unused))) {
+    }
+    size_t write(uint8_t aByte) {
+        return (putchar(aByte) == EOF) ? 0 : 1;
+    }
+    operator bool() {
+        return true;
+    }
+};
+extern HardwareSerial Serial; // To be defined by the simulation program
+
+#endif // _HOST_SIMULATION_ARDUINO_H
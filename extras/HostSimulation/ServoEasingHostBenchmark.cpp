@@ -0,0 +1,144 @@
+/*
+ * ServoEasingHostBenchmark.cpp
+ *
+ * Measures the host time of update() for each easing type and call style and for 1, 4 and 16 moving servos,
+ * and counts the I2C bytes per frame sent to a PCA9685 expander by the Wire.h stub.
+ * Prints one line "<easing type>;<number of servos>;<nanoseconds per update()>;<I2C bytes per frame>" for each combination.
+ *
+ * Build and run from the root directory of the library:
+ *   g++ -O2 -I extras/HostSimulation -I src extras/HostSimulation/ServoEasingHostBenchmark.cpp -o ServoEasingHostBenchmark
+ *   ./ServoEasingHostBenchmark
+ *
+ * Compare compile options by adding them to the g++ command line, e.g. -DUSE_FIXED_POINT_EASING, -DUSE_EASING_LOOKUP_TABLES,
+ * -DENABLE_PACKED_UPDATE_KERNEL or -DENABLE_PCA9685_FRAME_COMMIT for the I2C bytes.
+ * The warnings about the missing timer can be ignored, since only the update*() functions are used.
+ * The absolute values are of course different from the ones on your board, but the ratio between the options is similar for 32 bit CPUs.
+ * For values of your board, use the ServoEasingBenchmark example.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+
+// Must specify this before the include of "ServoEasing.hpp"
+#define USE_PCA9685_SERVO_EXPANDER      // The Wire.h stub counts the I2C bytes
+#define MAX_EASING_SERVOS 16
+#include "ServoEasing.hpp"
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+#define NUMBER_OF_UPDATES_PER_MEASUREMENT   200000L
+#define MILLIS_FOR_ONE_MOVE                 1000
+
+/*
+ * Virtual clock, which is advanced by REFRESH_INTERVAL_MICROS for each frame
+ */
+unsigned long sVirtualMicros = 0;
+unsigned long millis() {
+    return sVirtualMicros / 1000;
+}
+unsigned long micros() {
+    return sVirtualMicros;
+}
+void delay(unsigned long aMillis) {
+    sVirtualMicros += aMillis * 1000;
+}
+
+const uint8_t EasingTypesToMeasure[] = { EASE_LINEAR,
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+        EASE_QUADRATIC_IN, EASE_QUADRATIC_OUT, EASE_QUADRATIC_IN_OUT, EASE_QUADRATIC_BOUNCING,
+        EASE_CUBIC_IN, EASE_CUBIC_OUT, EASE_CUBIC_IN_OUT, EASE_CUBIC_BOUNCING,
+        EASE_QUARTIC_IN, EASE_QUARTIC_OUT, EASE_QUARTIC_IN_OUT, EASE_QUARTIC_BOUNCING,
+#  if !defined(DISABLE_COMPLEX_FUNCTIONS)
+        EASE_SINE_IN, EASE_SINE_OUT, EASE_SINE_IN_OUT, EASE_SINE_BOUNCING,
+        EASE_CIRCULAR_IN, EASE_CIRCULAR_OUT, EASE_CIRCULAR_IN_OUT, EASE_CIRCULAR_BOUNCING,
+        EASE_BACK_IN, EASE_BACK_OUT, EASE_BACK_IN_OUT, EASE_BACK_BOUNCING,
+        EASE_ELASTIC_IN, EASE_ELASTIC_OUT, EASE_ELASTIC_IN_OUT, EASE_ELASTIC_BOUNCING,
+        EASE_BOUNCE_IN, EASE_BOUNCE_OUT,
+#  endif
+#endif
+        };
+
+const uint8_t NumberOfServosToMeasure[] = { 1, 4, 16 };
+
+ServoEasing *sServos[MAX_EASING_SERVOS];
+
+/*
+ * Moves the first aNumberOfServos servos between 0 and 180 degree, until NUMBER_OF_UPDATES_PER_MEASUREMENT updates are done
+ */
+void measureEasingType(uint_fast8_t aEasingType, uint_fast8_t aNumberOfServos) {
+    for (uint_fast8_t i = 0; i < aNumberOfServos; ++i) {
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+        sServos[i]->setEasingType(aEasingType);
+#endif
+    }
+    int tTargetDegree = 180;
+    long tNumberOfFrames = 0;
+    Wire.NumberOfTransmittedBytes = 0;
+    std::chrono::nanoseconds tDuration(0);
+
+    while (tNumberOfFrames * aNumberOfServos < NUMBER_OF_UPDATES_PER_MEASUREMENT) {
+        for (uint_fast8_t i = 0; i < aNumberOfServos; ++i) {
+            sServos[i]->setEaseToD(tTargetDegree, MILLIS_FOR_ONE_MOVE);
+        }
+        synchronizeAllServosAndStartInterrupt(DO_NOT_START_UPDATE_BY_INTERRUPT);
+        // Measure the complete move, since reading the clock takes longer than one update()
+        auto tStart = std::chrono::steady_clock::now();
+        bool tAllServosStopped;
+        do {
+            sVirtualMicros += REFRESH_INTERVAL_MICROS;
+            tAllServosStopped = updateAllServos();
+#if defined(ENABLE_PCA9685_DEFERRED_TRANSFER)
+            transferStagedPCA9685Frames();
+#endif
+            tNumberOfFrames++;
+        } while (!tAllServosStopped);
+        tDuration += std::chrono::steady_clock::now() - tStart;
+        if ((aEasingType & CALL_STYLE_MASK) != CALL_STYLE_BOUNCING_OUT_IN) {
+            tTargetDegree = 180 - tTargetDegree; // a bouncing move ends at its start position
+        }
+    }
+
+    ServoEasing::printEasingType(&Serial, aEasingType);
+    Serial.print(';');
+    Serial.print(aNumberOfServos);
+    Serial.print(';');
+    Serial.print((double) tDuration.count() / (tNumberOfFrames * aNumberOfServos), 1);
+    Serial.print(';');
+    Serial.println((double) Wire.NumberOfTransmittedBytes / tNumberOfFrames, 1);
+}
+
+int main() {
+    Serial.println(F("Easing type;Servos;Nanoseconds per update();I2C bytes per frame"));
+    uint_fast8_t tNumberOfAttachedServos = 0;
+    for (uint_fast8_t tNumberOfServos : NumberOfServosToMeasure) {
+        // Attach the additional servos, the not moving servos are skipped by updateAllServos()
+        while (tNumberOfAttachedServos < tNumberOfServos) {
+            sServos[tNumberOfAttachedServos] = new ServoEasing(PCA9685_DEFAULT_ADDRESS);
+            sServos[tNumberOfAttachedServos]->attach(tNumberOfAttachedServos, 0);
+            tNumberOfAttachedServos++;
+        }
+        for (uint_fast8_t tEasingType : EasingTypesToMeasure) {
+            measureEasingType(tEasingType, tNumberOfServos);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * ServoEasingHostSimulation.cpp
+ *
+ * Runs a motion sequence with ServoEasing compiled with ENABLE_SIMULATION_MODE on the host, much faster than real time.
+ * Every servo write is printed as line "<milliseconds>;<servo index>;<microseconds>" to the file given as argument or to stdout.
+ * The trace is the same at each run, so changes of the motion code can be checked by comparing it with a golden trace.
+ *
+ * Build and run from the root directory of the library:
+ *   g++ -I extras/HostSimulation -I src extras/HostSimulation/ServoEasingHostSimulation.cpp -o ServoEasingHostSimulation
+ *   ./ServoEasingHostSimulation golden.csv                  # once, to create the golden trace
+ *   ./ServoEasingHostSimulation new.csv && diff golden.csv new.csv
+ *
+ * Feature macros of ServoEasing.h can be added to the g++ command line, e.g. -DENABLE_TELEMETRY_BUFFER -DUSE_FIXED_POINT_EASING.
+ * All macros, which do not select another servo library or a platform timer, compile here.
+ *
+ * Replace doDance() by your own sequence. delay() advances the virtual clock and runs the servo interrupt.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#include <Arduino.h>
+
+// Must specify this before the include of "ServoEasing.hpp"
+#define ENABLE_SIMULATION_MODE
+//#define ENABLE_MICROS_TIME_BASE       // Use micros() and 32 bit durations for internal timing of moves.
+//#define USE_FIXED_POINT_EASING        // Compare the traces with and without integer easing
+#define MAX_EASING_SERVOS 3
+#include "ServoEasing.hpp"
+
+HardwareSerial Serial;
+
+/*
+ * The virtual clock of ServoEasing is the only time base of the simulation
+ */
+unsigned long millis() {
+    return getServoEasingFrameTime() / SERVO_EASING_TIME_UNITS_PER_MILLISECOND;
+}
+unsigned long micros() {
+    return getServoEasingFrameTime() * (1000 / SERVO_EASING_TIME_UNITS_PER_MILLISECOND);
+}
+void delay(unsigned long aMillis) {
+    runSimulation(aMillis);
+}
+
+class FilePrint: public Print {
+public:
+    FILE *File;
+    FilePrint(FILE *aFile) {
+        File = aFile;
+    }
+    size_t write(uint8_t aByte) {
+        return (fputc(aByte, File) == EOF) ? 0 : 1;
+    }
+};
+
+ServoEasing Servo1;
+ServoEasing Servo2;
+ServoEasing Servo3;
+
+/*
+ * Uses the same kinds of moves and waits as the examples
+ */
+void doDance() {
+    // Blocking move without interrupt
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+    Servo1.setEasingType(EASE_CUBIC_IN_OUT);
+#endif
+    Servo1.easeTo(135, 60);
+
+    // Synchronized moves with interrupt
+    ServoEasing::ServoEasingNextPositionArray[0] = 45;
+    ServoEasing::ServoEasingNextPositionArray[1] = 180;
+    ServoEasing::ServoEasingNextPositionArray[2] = 0;
+    setEaseToForAllServosSynchronizeAndStartInterrupt(90);
+    while (ServoEasing::areInterruptsActive()) {
+        ; // every call emulates the next servo interrupt
+    }
+    delay(500);
+
+    // Independent moves with interrupt, waiting with delay()
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+    Servo2.setEasingType(EASE_QUADRATIC_IN_OUT);
+#  if !defined(DISABLE_COMPLEX_FUNCTIONS)
+    Servo3.setEasingType(EASE_SINE_IN_OUT);
+#  endif
+#endif
+    Servo2.startEaseToD(90, 800);
+    Servo3.startEaseTo(90, 45);
+    delay(3000);
+
+    // Own update loop without interrupt
+    setSpeedForAllServos(120);
+    ServoEasing::ServoEasingNextPositionArray[0] = 90;
+    ServoEasing::ServoEasingNextPositionArray[1] = 0;
+    ServoEasing::ServoEasingNextPositionArray[2] = 180;
+    setEaseToForAllServos();
+    synchronizeAllServosAndStartInterrupt(false);
+    do {
+        delay(REFRESH_INTERVAL_MILLIS);
+    } while (!updateAllServos());
+}
+
+int main(int argc, char *argv[]) {
+    FILE *tTraceFile = stdout;
+    if (argc > 1) {
+        tTraceFile = fopen(argv[1], "w");
+        if (tTraceFile == NULL) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    FilePrint tTraceOutput(tTraceFile);
+    setSimulationTraceOutput(&tTraceOutput);
+
+    Servo1.attach(9, 90);
+    Servo2.attach(10, 90);
+    Servo3.attach(11, 90);
+    doDance();
+
+    if (tTraceFile != stdout) {
+        fclose(tTraceFile);
+    }
+    return 0;
+}
@@ -0,0 +1,451 @@
+/*
+ * ServoEasingHostTests.cpp
+ *
+ * Checks ServoEasing compiled with ENABLE_SIMULATION_MODE on the host for cases, which are hard to see in a trace.
+ * Each check is only compiled, if the feature it checks is enabled, so build it once for each feature to check.
+ * Prints the failed checks and returns 1 if at least one check failed.
+ *
+ * Build and run from the root directory of the library:
+ *   g++ -I extras/HostSimulation -I src -DENABLE_SIMD_PACKED_UPDATE_KERNEL extras/HostSimulation/ServoEasingHostTests.cpp -o ServoEasingHostTests
+ *   ./ServoEasingHostTests
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#include <Arduino.h>
+
+// Must specify this before the include of "ServoEasing.hpp"
+#define ENABLE_SIMULATION_MODE
+#define MAX_EASING_SERVOS 4
+#include "ServoEasing.hpp"
+
+HardwareSerial Serial;
+
+/*
+ * The virtual clock of ServoEasing is the only time base of the tests
+ */
+unsigned long millis() {
+    return getServoEasingFrameTime() / SERVO_EASING_TIME_UNITS_PER_MILLISECOND;
+}
+unsigned long micros() {
+    return getServoEasingFrameTime() * (1000 / SERVO_EASING_TIME_UNITS_PER_MILLISECOND);
+}
+void delay(unsigned long aMillis) {
+    runSimulation(aMillis);
+}
+
+ServoEasing Servo1;
+ServoEasing Servo2;
+
+uint16_t sNumberOfChecks = 0;
+uint16_t sNumberOfFailedChecks = 0;
+
+void check(bool aCondition, const char *aTestName, const char *aMessage, long aValue) {
+    sNumberOfChecks++;
+    if (!aCondition) {
+        sNumberOfFailedChecks++;
+        printf("FAILED %s: %s %ld\n", aTestName, aMessage, aValue);
+    }
+}
+
+#if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL) && !defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
+void startServo2AtEndOfServo1Move(ServoEasing *aServo __attribute__((unused))) {
+    Servo2.startEaseToD(90, 1000);
+}
+
+/*
+ * The positions of the SIMD kernel are computed at the start of the frame.
+ * A move started by the callback of a servo with a lower index must not use the position computed for its previous move.
+ */
+void testPackedKernelMoveStartedByCallback() {
+    Servo1.attach(9, 0);
+    Servo2.attach(10, 0);
+    Servo2.startEaseToD(180, 200);
+    Servo1.setTargetPositionReachedHandler(&startServo2AtEndOfServo1Move);
+    Servo1.startEaseToD(90, 400);
+
+    int tLastMicroseconds = Servo2.mCurrentMicrosecondsOrUnits;
+    int tMaxStep = 0;
+    while (ServoEasing::areInterruptsActive()) {
+        int tStep = abs(Servo2.mCurrentMicrosecondsOrUnits - tLastMicroseconds);
+        if (tMaxStep < tStep) {
+            tMaxStep = tStep;
+        }
+        tLastMicroseconds = Servo2.mCurrentMicrosecondsOrUnits;
+    }
+    // The fastest move is 180 degree in 200 ms, i.e. below 200 us per 20 ms frame
+    check(tMaxStep < 200, "testPackedKernelMoveStartedByCallback", "Maximum microseconds per frame", tMaxStep);
+    check(Servo2.mCurrentMicrosecondsOrUnits == Servo2.DegreeOrMicrosecondToMicrosecondsOrUnits(90),
+            "testPackedKernelMoveStartedByCallback", "End microseconds", Servo2.mCurrentMicrosecondsOrUnits);
+
+    Servo1.setTargetPositionReachedHandler(NULL);
+    Servo1.detach();
+    Servo2.detach();
+}
+#endif
+
+#if defined(ENABLE_EASE_S_CURVE)
+/*
+ * @return The peak acceleration in degrees per second squared, computed from the segments of the first half of the S-curve
+ */
+float getSCurvePeakAcceleration(ServoEasing *aServo) {
+    float tMillis = aServo->mMillisForCompleteMove / SERVO_EASING_TIME_UNITS_PER_MILLISECOND;
+    float tDegrees = abs(
+            aServo->MicrosecondsOrUnitsToDegree(aServo->mEndMicrosecondsOrUnits)
+                    - aServo->MicrosecondsOrUnitsToDegree(aServo->mStartMicrosecondsOrUnits));
+    float tTimeFactor = tMillis / (FIXED_POINT_ONE * 1000.0); // seconds per Q15 time unit
+    float tPositionFactor = tDegrees / FIXED_POINT_ONE; // degrees per Q15 position unit
+    uint16_t *tSegmentEnd = aServo->mSCurveSegments.SegmentEnd;
+    uint16_t *tSegmentEndPosition = aServo->mSCurveSegments.SegmentEndPosition;
+    float tJerkUpPosition = tSegmentEndPosition[0] * tPositionFactor;
+
+    // jerk up: position = p0 * u^3, acceleration at the end is 6 * p0
+    float tSegmentSeconds = tSegmentEnd[0] * tTimeFactor;
+    float tPeakAcceleration = 0;
+    if (tSegmentSeconds > 0) {
+        tPeakAcceleration = 6 * tJerkUpPosition / (tSegmentSeconds * tSegmentSeconds);
+    }
+    // constant acceleration: position = p0 + delta * u + quadratic part * u^2
+    tSegmentSeconds = (tSegmentEnd[1] - tSegmentEnd[0]) * tTimeFactor;
+    if (tSegmentSeconds > 0) {
+        float tQuadraticPart = (tSegmentEndPosition[1] - tSegmentEndPosition[0] - aServo->mSCurveSegments.ConstantAccelerationStartDelta)
+                * tPositionFactor;
+        tPeakAcceleration = fmaxf(tPeakAcceleration, 2 * tQuadraticPart / (tSegmentSeconds * tSegmentSeconds));
+    }
+    // jerk down: the u^2 part is 3 * p0 * u^2, acceleration at the start is 6 * p0
+    tSegmentSeconds = (tSegmentEnd[2] - tSegmentEnd[1]) * tTimeFactor;
+    if (tSegmentSeconds > 0) {
+        tPeakAcceleration = fmaxf(tPeakAcceleration, 6 * tJerkUpPosition / (tSegmentSeconds * tSegmentSeconds));
+    }
+    return tPeakAcceleration;
+}
+
+/*
+ * The minimum duration for a speed must allow a profile, which does not exceed the acceleration limit
+ */
+void testSCurveAccelerationLimit() {
+    const uint16_t tTestValues[][4] = { // degrees, degrees per second, acceleration, jerk
+            { 90, 200, 360, 1440 }, // acceleration limit reached, speed not reached
+            { 170, 90, 360, 1440 }, // all limits reached
+            { 10, 200, 360, 1440 }, // only jerk segments
+            { 150, 300, 200, 4000 }, { 60, 400, 1000, 2000 } };
+    Servo1.attach(9, 0);
+    Servo1.setEasingType(EASE_S_CURVE);
+    for (uint_fast8_t i = 0; i < sizeof(tTestValues) / sizeof(tTestValues[0]); ++i) {
+        Servo1.write(0);
+        Servo1.setMaxAcceleration(tTestValues[i][2]);
+        Servo1.setMaxJerk(tTestValues[i][3]);
+        Servo1.startEaseTo(tTestValues[i][0], tTestValues[i][1], DO_NOT_START_UPDATE_BY_INTERRUPT);
+        float tPeakAcceleration = getSCurvePeakAcceleration(&Servo1);
+        // 2 percent for the Q15 rounding of the segments
+        check(tPeakAcceleration <= tTestValues[i][2] * 1.02, "testSCurveAccelerationLimit", "Peak acceleration",
+                tPeakAcceleration);
+        Servo1.stop();
+    }
+    // 90 degree at 200 degree per second and 360 degree per second squared takes 1/4 + sqrt(1/16 + 1) seconds
+    Servo1.write(0);
+    Servo1.setMaxAcceleration(360);
+    Servo1.setMaxJerk(1440);
+    Servo1.startEaseTo(90, 200, DO_NOT_START_UPDATE_BY_INTERRUPT);
+    check(Servo1.mMillisForCompleteMove / SERVO_EASING_TIME_UNITS_PER_MILLISECOND == 1281, "testSCurveAccelerationLimit",
+            "Milliseconds for 90 degree", Servo1.mMillisForCompleteMove / SERVO_EASING_TIME_UNITS_PER_MILLISECOND);
+    Servo1.stop();
+    Servo1.detach();
+}
+#endif
+
+#if defined(ENABLE_BATCHED_MOVE_SETUP) && defined(ENABLE_EASE_S_CURVE)
+/*
+ * The S-curve segments computed before the critical section must be the ones of the move set up in the critical section
+ */
+void testBatchedMoveSetupSCurveSegments() {
+    Servo1.attach(9, 0);
+    Servo2.attach(10, 0);
+    Servo1.setEasingType(EASE_S_CURVE);
+    Servo2.setEasingType(EASE_S_CURVE);
+    ServoEasingPositionType tTargetPositions[MAX_EASING_SERVOS] = { 90, 30 };
+    setEaseToArrayPositionsSynchronizeAndStartInterrupt(tTargetPositions, 60, DO_NOT_START_UPDATE_BY_INTERRUPT);
+
+    ServoEasing *tServos[] = { &Servo1, &Servo2 };
+    for (uint_fast8_t i = 0; i < 2; ++i) {
+        ServoEasingSCurveSegmentsStruct tSetUpSegments = tServos[i]->mSCurveSegments;
+        tServos[i]->setSCurveSegments();
+        check(memcmp(&tSetUpSegments, &tServos[i]->mSCurveSegments, sizeof(tSetUpSegments)) == 0,
+                "testBatchedMoveSetupSCurveSegments", "Segments differ for servo", i);
+    }
+    check(Servo1.mMillisForCompleteMove == Servo2.mMillisForCompleteMove, "testBatchedMoveSetupSCurveSegments",
+            "Duration differs", Servo2.mMillisForCompleteMove);
+    Servo1.stop();
+    Servo2.stop();
+    Servo1.detach();
+    Servo2.detach();
+}
+#endif
+
+#if defined(ENABLE_MOTION_QUEUE)
+/*
+ * clearMotionQueue() only requests the clear, which is done by update().
+ * The moves queued before the clear must be discarded, the moves queued after it must be kept.
+ */
+void testMotionQueueClear() {
+    Servo1.attach(9, 0);
+    Servo1.startEaseToD(90, 200);
+    Servo1.queueEaseToD(10, 200);
+    Servo1.queueEaseToD(20, 200);
+    Servo1.stop(); // the servo is not updated any more, so the clear stays pending
+    check(Servo1.getNumberOfQueuedMoves() == 0, "testMotionQueueClear", "Queued moves after stop", Servo1.getNumberOfQueuedMoves());
+    Servo1.queueEaseToD(0, 200); // is started directly
+    Servo1.queueEaseToD(45, 200);
+    check(Servo1.getNumberOfQueuedMoves() == 1, "testMotionQueueClear", "Queued moves", Servo1.getNumberOfQueuedMoves());
+    int tMinAngle = 180;
+    while (ServoEasing::areInterruptsActive()) {
+        if (tMinAngle > Servo1.getCurrentAngle()) {
+            tMinAngle = Servo1.getCurrentAngle();
+        }
+    }
+    check(Servo1.getCurrentAngle() == 45, "testMotionQueueClear", "End angle", Servo1.getCurrentAngle());
+    check(tMinAngle == 0, "testMotionQueueClear", "Minimum angle", tMinAngle);
+    Servo1.detach();
+}
+#endif
+
+#if defined(ENABLE_POSITION_FRAME_RECEIVER)
+uint8_t sFrameCRC;
+void receiveFrameByte(uint8_t aByte) {
+    for (uint_fast8_t i = 0; i < 8; ++i) {
+        sFrameCRC = ((sFrameCRC ^ (aByte << i)) & 0x80) ? (sFrameCRC << 1) ^ 0x07 : sFrameCRC << 1;
+    }
+    if (aByte == POSITION_FRAME_SYNC_BYTE || aByte == POSITION_FRAME_ESCAPE_BYTE) {
+        receivePositionFrameByte(POSITION_FRAME_ESCAPE_BYTE);
+        aByte ^= POSITION_FRAME_ESCAPE_XOR;
+    }
+    receivePositionFrameByte(aByte);
+}
+
+/*
+ * Sends a frame with duration and one target for servo 0
+ */
+void receiveFrameForServo1(uint16_t aMillisForMove, int16_t aTarget) {
+    sFrameCRC = 0;
+    receivePositionFrameByte(POSITION_FRAME_SYNC_BYTE);
+    const uint8_t tBytes[] = { POSITION_FRAME_FLAG_DURATION, 0x01, 0, 0, 0, (uint8_t) aMillisForMove, (uint8_t) (aMillisForMove >> 8),
+            (uint8_t) aTarget, (uint8_t) (aTarget >> 8) };
+    for (uint_fast8_t i = 0; i < sizeof(tBytes); ++i) {
+        receiveFrameByte(tBytes[i]);
+    }
+    uint8_t tCRC = sFrameCRC;
+    receiveFrameByte(tCRC);
+}
+
+/*
+ * A frame must only synchronize the servos of its mask, and must start them at the current time
+ */
+void testPositionFrameSynchronizesOnlyItsServos() {
+    Servo1.attach(9, 0);
+    Servo2.attach(10, 0);
+    Servo2.startEaseToD(180, 1000);
+    runSimulation(200);
+    uint32_t tServo2MillisAtStartMove = Servo2.mMillisAtStartMove;
+    ServoEasingDurationType tServo2MillisForCompleteMove = Servo2.mMillisForCompleteMove;
+
+    receiveFrameForServo1(300, 90);
+    check(startReceivedPositionFrame(), "testPositionFrameSynchronizesOnlyItsServos", "Frame started", 0);
+    check(Servo2.mMillisAtStartMove == tServo2MillisAtStartMove, "testPositionFrameSynchronizesOnlyItsServos",
+            "Start of servo outside mask changed by", Servo2.mMillisAtStartMove - tServo2MillisAtStartMove);
+    check(Servo2.mMillisForCompleteMove == tServo2MillisForCompleteMove, "testPositionFrameSynchronizesOnlyItsServos",
+            "Duration of servo outside mask", Servo2.mMillisForCompleteMove);
+    check(Servo1.mMillisAtStartMove == getServoEasingTime(), "testPositionFrameSynchronizesOnlyItsServos",
+            "Start of servo in mask is before now by", getServoEasingTime() - Servo1.mMillisAtStartMove);
+    check(Servo1.mMillisForCompleteMove == 300 * SERVO_EASING_TIME_UNITS_PER_MILLISECOND, "testPositionFrameSynchronizesOnlyItsServos",
+            "Duration of servo in mask", Servo1.mMillisForCompleteMove);
+    while (ServoEasing::areInterruptsActive()) {
+    }
+    Servo1.detach();
+    Servo2.detach();
+}
+#endif
+
+#if defined(ENABLE_UPDATE_PRIORITY_ORDER) && !defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
+ServoEasing Servo3;
+void changePrioritiesTwice(ServoEasing *aServo __attribute__((unused))) {
+    Servo1.setUpdatePriority(0);
+    Servo3.setUpdatePriority(5);
+}
+
+/*
+ * Two sorts in one frame must not change the update order, which is just iterated by updateAllServos()
+ */
+void testUpdateOrderSortedTwiceInOneFrame() {
+    Servo1.attach(9, 0);
+    Servo2.attach(10, 0);
+    Servo3.attach(11, 0);
+    Servo1.setUpdatePriority(3);
+    Servo2.setUpdatePriority(2);
+    Servo3.setUpdatePriority(1);
+    Servo3.startEaseToD(180, 1000);
+    Servo2.startEaseToD(180, 1000);
+    Servo1.setTargetPositionReachedHandler(&changePrioritiesTwice);
+    Servo1.startEaseToD(90, 200);
+
+    int tMinimumStep = 1000;
+    int tLastMicroseconds = Servo3.mCurrentMicrosecondsOrUnits;
+    while (Servo3.isMoving()) {
+        runSimulation(REFRESH_INTERVAL_MILLIS);
+        int tStep = Servo3.mCurrentMicrosecondsOrUnits - tLastMicroseconds;
+        if (tMinimumStep > tStep) {
+            tMinimumStep = tStep;
+        }
+        tLastMicroseconds = Servo3.mCurrentMicrosecondsOrUnits;
+    }
+    check(tMinimumStep > 0, "testUpdateOrderSortedTwiceInOneFrame", "Minimum microseconds per frame", tMinimumStep);
+    check(ServoEasing::sServoUpdateOrder[ServoEasing::sServoUpdateOrderBufferIndex][0] == Servo3.mServoIndex,
+            "testUpdateOrderSortedTwiceInOneFrame", "First servo index", ServoEasing::sServoUpdateOrder[ServoEasing::sServoUpdateOrderBufferIndex][0]);
+
+    Servo1.setTargetPositionReachedHandler(NULL);
+    Servo1.detach();
+    Servo2.detach();
+    Servo3.detach();
+}
+#endif
+
+#if defined(ENABLE_RETARGET)
+/*
+ * Retargets a 180 degree per second move at 90 degree and checks, that all positions are within the servo range,
+ * that a retarget in the same direction does not reverse and that the new target is reached
+ */
+void checkRetarget(int aTargetDegree, uint_fast16_t aDegreesPerSecond, const char *aTestName) {
+    Servo1.attach(9, 0);
+    Servo1.startEaseTo(180, 180);
+    delay(500);
+    int tStartMicroseconds = Servo1.mCurrentMicrosecondsOrUnits;
+    bool tIsSameDirection = Servo1.DegreeOrMicrosecondToMicrosecondsOrUnits(aTargetDegree) > tStartMicroseconds;
+    Servo1.retarget(aTargetDegree, aDegreesPerSecond, START_UPDATE_BY_INTERRUPT);
+
+    int tMinimumMicroseconds = tStartMicroseconds;
+    int tMaximumMicroseconds = tStartMicroseconds;
+    int tMinimumStep = 0;
+    int tLastMicroseconds = tStartMicroseconds;
+    while (ServoEasing::areInterruptsActive()) {
+        int tMicroseconds = Servo1.mCurrentMicrosecondsOrUnits;
+        if (tMinimumMicroseconds > tMicroseconds) {
+            tMinimumMicroseconds = tMicroseconds;
+        }
+        if (tMaximumMicroseconds < tMicroseconds) {
+            tMaximumMicroseconds = tMicroseconds;
+        }
+        if (tMinimumStep > tMicroseconds - tLastMicroseconds) {
+            tMinimumStep = tMicroseconds - tLastMicroseconds;
+        }
+        tLastMicroseconds = tMicroseconds;
+    }
+    check(tMinimumMicroseconds >= Servo1.DegreeOrMicrosecondToMicrosecondsOrUnits(0), aTestName, "Minimum microseconds",
+            tMinimumMicroseconds);
+    check(tMaximumMicroseconds <= Servo1.DegreeOrMicrosecondToMicrosecondsOrUnits(180), aTestName, "Maximum microseconds",
+            tMaximumMicroseconds);
+    if (tIsSameDirection) {
+        check(tMinimumStep >= 0, aTestName, "Minimum microseconds per frame", tMinimumStep);
+    }
+    check(Servo1.mCurrentMicrosecondsOrUnits == Servo1.DegreeOrMicrosecondToMicrosecondsOrUnits(aTargetDegree), aTestName,
+            "End microseconds", Servo1.mCurrentMicrosecondsOrUnits);
+    Servo1.detach();
+}
+
+void testRetargetStaysInRange() {
+    checkRetarget(170, 10, "testRetargetSlowSameDirection");
+    checkRetarget(170, 180, "testRetargetEqualSameDirection");
+    checkRetarget(0, 10, "testRetargetSlowReversed");
+    checkRetarget(0, 180, "testRetargetEqualReversed");
+    checkRetarget(180, 10, "testRetargetSlowToRangeEnd");
+}
+#endif
+
+#if defined(ENABLE_STALL_DETECTION) && defined(ENABLE_DENSE_SERVO_REGISTRY)
+ServoEasing Servo3;
+uint8_t sNumberOfStallHandlerCalls = 0;
+
+uint16_t getCurrentOfServo1(uint8_t aCurrentIndex) {
+    return (aCurrentIndex == 0) ? 1000 : 0; // Servo1 is blocked
+}
+void countStalls(ServoEasing *aServo __attribute__((unused))) {
+    sNumberOfStallHandlerCalls++;
+}
+
+/*
+ * The detach() of a stalled servo moves the last servo of the dense registry to the slot of the stalled servo.
+ * This must not happen while updateAllServos() processes the registry, otherwise the moved servo misses one frame.
+ */
+void testStallDetachDoesNotSkipServo() {
+    Servo1.attach(9, 0);
+    Servo2.attach(10, 0);
+    Servo3.attach(11, 0);
+    Servo1.setStallDetection(&getCurrentOfServo1, 0, 500, 3, STALL_ACTION_DETACH);
+    Servo1.setStallHandler(&countStalls);
+    Servo1.setEaseToD(180, 1000);
+    Servo2.setEaseToD(180, 1000);
+    Servo3.setEaseToD(180, 1000);
+    synchronizeAllServosAndStartInterrupt();
+
+    int tLastMicroseconds = Servo3.mCurrentMicrosecondsOrUnits;
+    int tNumberOfFramesWithoutStep = 0;
+    while (ServoEasing::areInterruptsActive()) {
+        if (Servo3.mServoMoves && Servo3.mCurrentMicrosecondsOrUnits == tLastMicroseconds) {
+            tNumberOfFramesWithoutStep++;
+        }
+        tLastMicroseconds = Servo3.mCurrentMicrosecondsOrUnits;
+    }
+    check(Servo1.mServoIndex == INVALID_SERVO, "testStallDetachDoesNotSkipServo", "Servo index of stalled servo", Servo1.mServoIndex);
+    check(sNumberOfStallHandlerCalls == 1, "testStallDetachDoesNotSkipServo", "Stall handler calls", sNumberOfStallHandlerCalls);
+    // A linear move of 180 degree in 1000 ms changes the position in each 20 ms frame
+    check(tNumberOfFramesWithoutStep == 0, "testStallDetachDoesNotSkipServo", "Frames without step of last servo",
+            tNumberOfFramesWithoutStep);
+
+    Servo2.detach();
+    Servo3.detach();
+}
+#endif
+
+int main() {
+#if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL) && !defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
+    testPackedKernelMoveStartedByCallback();
+#endif
+#if defined(ENABLE_EASE_S_CURVE)
+    testSCurveAccelerationLimit();
+#endif
+#if defined(ENABLE_BATCHED_MOVE_SETUP) && defined(ENABLE_EASE_S_CURVE)
+    testBatchedMoveSetupSCurveSegments();
+#endif
+#if defined(ENABLE_MOTION_QUEUE)
+    testMotionQueueClear();
+#endif
+#if defined(ENABLE_POSITION_FRAME_RECEIVER)
+    testPositionFrameSynchronizesOnlyItsServos();
+#endif
+#if defined(ENABLE_UPDATE_PRIORITY_ORDER) && !defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
+    testUpdateOrderSortedTwiceInOneFrame();
+#endif
+#if defined(ENABLE_RETARGET)
+    testRetargetStaysInRange();
+#endif
+#if defined(ENABLE_STALL_DETECTION) && defined(ENABLE_DENSE_SERVO_REGISTRY)
+    testStallDetachDoesNotSkipServo();
+#endif
+
+    printf("%u of %u checks failed\n", sNumberOfFailedChecks, sNumberOfChecks);
+    return (sNumberOfFailedChecks == 0) ? 0 : 1;
+}
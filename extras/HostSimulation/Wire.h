@@ -0,0 +1,64 @@
+/*
+ * Wire.h
+ *
+ * Minimal Wire API for compiling ServoEasing with USE_PCA9685_SERVO_EXPANDER on the host, e.g. Linux or Windows with g++.
+ * No bus is accessed, all transmissions succeed and the bytes are only counted, see ServoEasingHostBenchmark.cpp.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _HOST_SIMULATION_WIRE_H
+#define _HOST_SIMULATION_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+    uint32_t NumberOfTransmittedBytes = 0; // including the address byte of each transmission
+
+    void begin() {
+    }
+    void setClock(uint32_t aClockFrequency __attribute__((unused))) {
+    }
+    void setWireTimeout(uint32_t aTimeoutMicros __attribute__((unused)), bool aResetWithTimeout __attribute__((unused))) {
+    }
+    void beginTransmission(uint8_t aAddress __attribute__((unused))) {
+        NumberOfTransmittedBytes++;
+    }
+    size_t write(uint8_t aByte __attribute__((unused))) {
+        NumberOfTransmittedBytes++;
+        return 1;
+    }
+    size_t write(const uint8_t *aBuffer __attribute__((unused)), size_t aSize) {
+        NumberOfTransmittedBytes += aSize;
+        return aSize;
+    }
+    uint8_t endTransmission(bool aSendStop __attribute__((unused)) = true) {
+        return 0;
+    }
+    uint8_t requestFrom(uint8_t aAddress __attribute__((unused)), uint8_t aQuantity) {
+        return aQuantity;
+    }
+    int read() {
+        return 0;
+    }
+};
+extern TwoWire Wire; // To be defined by the program
+
+#endif // _HOST_SIMULATION_WIRE_H
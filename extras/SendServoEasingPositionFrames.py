@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+#
+# SendServoEasingPositionFrames.py
+#
+# Encodes and sends the binary position frames received by receivePositionFrames() of ServoEasing
+# compiled with ENABLE_POSITION_FRAME_RECEIVER. Can be imported to use encodePositionFrame() in your own program.
+#
+# Usage: SendServoEasingPositionFrames.py /dev/ttyUSB0 <duration ms or -1 for speed> <target of servo 0> [<target of servo 1> ...]
+#        Example: SendServoEasingPositionFrames.py /dev/ttyUSB0 500 90 120 45   (requires pyserial)
+#
+#  Copyright (C) 2022  Armin Joachimsmeyer
+#  armin.joachimsmeyer@gmail.com
+#
+#  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+#
+#  ServoEasing is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import struct
+import sys
+
+POSITION_FRAME_SYNC_BYTE = 0x5A
+POSITION_FRAME_ESCAPE_BYTE = 0x5B
+POSITION_FRAME_ESCAPE_XOR = 0x20
+POSITION_FRAME_FLAG_DURATION = 0x01
+
+
+def crc8(aBytes):
+    tCRC = 0
+    for tByte in aBytes:
+        tCRC ^= tByte
+        for _ in range(8):
+            tCRC = ((tCRC << 1) ^ 0x07) & 0xFF if tCRC & 0x80 else (tCRC << 1) & 0xFF
+    return tCRC
+
+
+def encodePositionFrame(aTargets, aMillisForMove=None):
+    """
+    aTargets: dictionary of servo index -> degree or microsecond value, or list of values for servo 0 to n
+    aMillisForMove: duration for all moves, None -> the speed set by setSpeed() is used
+    """
+    if not isinstance(aTargets, dict):
+        aTargets = dict(enumerate(aTargets))
+    tServoMask = 0
+    for tServoIndex in aTargets:
+        tServoMask |= 1 << tServoIndex
+    tFlags = 0 if aMillisForMove is None else POSITION_FRAME_FLAG_DURATION
+    tContent = struct.pack('<BI', tFlags, tServoMask)
+    if aMillisForMove is not None:
+        tContent += struct.pack('<H', aMillisForMove)
+    for tServoIndex in sorted(aTargets):
+        tContent += struct.pack('<h', int(aTargets[tServoIndex]))
+    tContent += bytes([crc8(tContent)])
+
+    tFrame = bytearray([POSITION_FRAME_SYNC_BYTE])
+    for tByte in tContent:
+        if tByte in (POSITION_FRAME_SYNC_BYTE, POSITION_FRAME_ESCAPE_BYTE):
+            tFrame += bytes([POSITION_FRAME_ESCAPE_BYTE, tByte ^ POSITION_FRAME_ESCAPE_XOR])
+        else:
+            tFrame.append(tByte)
+    return bytes(tFrame)
+
+
+def main():
+    if len(sys.argv) < 4:
+        print('Usage: {} <serial port> <duration ms or -1> <target of servo 0> [<target of servo 1> ...]'.format(sys.argv[0]))
+        sys.exit(1)
+    import serial
+    tMillisForMove = int(sys.argv[2])
+    tTargets = [int(tValue) for tValue in sys.argv[3:]]
+    with serial.Serial(sys.argv[1], 115200) as tSerial:
+        tSerial.write(encodePositionFrame(tTargets, None if tMillisForMove < 0 else tMillisForMove))
+
+
+if __name__ == '__main__':
+    main()
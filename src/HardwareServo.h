@@ -0,0 +1,84 @@
+/*
+ * HardwareServo.h
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _HARDWARE_SERVO_H
+#define _HARDWARE_SERVO_H
+
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040) || defined(STM32F1xx)
+
+#define VERSION_HARDWARE_SERVO "1.0.0"
+#define VERSION_HARDWARE_SERVO_MAJOR 1
+#define VERSION_HARDWARE_SERVO_MINOR 0
+
+#include <stdint.h>
+
+/*
+ * Servo pulses generated entirely by the PWM hardware, a write only sets the new compare value,
+ * which is taken by the hardware at the start of the next period.
+ * ESP32:  LEDC channels HARDWARE_SERVO_FIRST_LEDC_CHANNEL to HARDWARE_SERVO_FIRST_LEDC_CHANNEL + HARDWARE_SERVO_MAX_CHANNELS - 1.
+ *         The resolution is 0.3 us for 16 bit (ESP32) and 1.2 us for 14 bit (ESP32-S2, -S3 and -C3) at 20 ms period.
+ * RP2040: PWM slices, every GPIO can be used. GPIO n and n + 16 share the same PWM channel, so only one of them can be used.
+ *         All PWM slices used for servos are set to the servo period, so do not use analogWrite() on the other channel of a slice.
+ *         The resolution is 0.3 us at 20 ms period.
+ * STM32F1xx: PWM channels of the timers available at the pin (see PinMap_PWM of your board), up to 4 servos per timer.
+ *         The compare registers are preloaded, so all channels of a timer take their new values together at the update event.
+ *         TIM4 is used for the ServoEasing interrupt and cannot be used for servos.
+ *         The resolution is 0.3 us at 72 MHz and 20 ms period.
+ */
+#if !defined(HARDWARE_SERVO_REFRESH_INTERVAL_MICROS)
+#define HARDWARE_SERVO_REFRESH_INTERVAL_MICROS  20000
+#endif
+#if defined(ESP32)
+#  if !defined(HARDWARE_SERVO_MAX_CHANNELS)
+#define HARDWARE_SERVO_MAX_CHANNELS             8 // Number of LEDC channels used, all ESP32 variants have at least 6
+#  endif
+#  if !defined(HARDWARE_SERVO_FIRST_LEDC_CHANNEL)
+#define HARDWARE_SERVO_FIRST_LEDC_CHANNEL       0
+#  endif
+#  if !defined(HARDWARE_SERVO_LEDC_RESOLUTION_BITS)
+#    if defined(CONFIG_IDF_TARGET_ESP32)
+#define HARDWARE_SERVO_LEDC_RESOLUTION_BITS     16
+#    else
+#define HARDWARE_SERVO_LEDC_RESOLUTION_BITS     14 // ESP32-S2, -S3 and -C3 support only 14 bit
+#    endif
+#  endif
+#elif defined(ARDUINO_ARCH_RP2040)
+#  if !defined(HARDWARE_SERVO_MAX_CHANNELS)
+#define HARDWARE_SERVO_MAX_CHANNELS             16 // 8 slices with 2 channels
+#  endif
+#else
+#  if !defined(HARDWARE_SERVO_MAX_TIMERS)
+#define HARDWARE_SERVO_MAX_TIMERS               3 // Number of different timers the servo pins may be connected to
+#  endif
+#  if !defined(HARDWARE_SERVO_MAX_CHANNELS)
+#define HARDWARE_SERVO_MAX_CHANNELS             (HARDWARE_SERVO_MAX_TIMERS * 4)
+#  endif
+#endif
+
+bool initHardwareServoPin(uint8_t aPin); // Returns false if all channels are in use or the channel of the pin is used by another pin
+void deinitHardwareServoPin(uint8_t aPin);
+void writeMicrosecondsHardwareServoPin(int aMicroseconds, uint8_t aPin);
+
+#endif // defined(ESP32) || defined(ARDUINO_ARCH_RP2040) || defined(STM32F1xx)
+
+#endif // _HARDWARE_SERVO_H
@@ -0,0 +1,269 @@
+/*
+ *  HardwareServo.hpp
+ *
+ *  Servo pulses generated by the LEDC peripheral of the ESP32, the PWM slices of the RP2040 or the timers of the STM32.
+ *  No CPU time is required for the pulses, and the resolution is better than 1 microsecond.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _HARDWARE_SERVO_HPP
+#define _HARDWARE_SERVO_HPP
+
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040) || defined(STM32F1xx)
+#include "HardwareServo.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#endif
+
+/*
+ * For RP2040 the index is the PWM channel number (slice * 2 + channel)
+ */
+uint8_t sHardwareServoPins[HARDWARE_SERVO_MAX_CHANNELS];
+uint16_t sHardwareServoUsedChannelMask; // Bit n is set if sHardwareServoPins[n] is valid
+
+/*
+ * @return Index in sHardwareServoPins or HARDWARE_SERVO_MAX_CHANNELS if pin is not attached
+ */
+uint_fast8_t getHardwareServoChannelIndex(uint8_t aPin) {
+    uint_fast8_t tIndex = 0;
+    for (; tIndex < HARDWARE_SERVO_MAX_CHANNELS; ++tIndex) {
+        if ((sHardwareServoUsedChannelMask & (1 << tIndex)) && sHardwareServoPins[tIndex] == aPin) {
+            break;
+        }
+    }
+    return tIndex;
+}
+
+#if defined(ESP32)
+/*
+ * Compare value = microseconds * 2^resolution / period
+ */
+uint32_t getHardwareServoLedcDuty(int aMicroseconds) {
+    return ((((uint32_t) aMicroseconds) << HARDWARE_SERVO_LEDC_RESOLUTION_BITS) + (HARDWARE_SERVO_REFRESH_INTERVAL_MICROS / 2))
+            / HARDWARE_SERVO_REFRESH_INTERVAL_MICROS;
+}
+
+bool initHardwareServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+        return true; // already attached
+    }
+    // Take the first free channel
+    for (tChannelIndex = 0; tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS; ++tChannelIndex) {
+        if (!(sHardwareServoUsedChannelMask & (1 << tChannelIndex))) {
+            break;
+        }
+    }
+    if (tChannelIndex >= HARDWARE_SERVO_MAX_CHANNELS) {
+        return false; // all channels are in use
+    }
+#  if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    // Core 3.x assigns the channels itself
+    if (!ledcAttach(aPin, 1000000L / HARDWARE_SERVO_REFRESH_INTERVAL_MICROS, HARDWARE_SERVO_LEDC_RESOLUTION_BITS)) {
+        return false;
+    }
+    ledcWrite(aPin, 0);
+#  else
+    uint8_t tLedcChannel = HARDWARE_SERVO_FIRST_LEDC_CHANNEL + tChannelIndex;
+    ledcSetup(tLedcChannel, 1000000L / HARDWARE_SERVO_REFRESH_INTERVAL_MICROS, HARDWARE_SERVO_LEDC_RESOLUTION_BITS);
+    ledcWrite(tLedcChannel, 0); // no pulse until first write
+    ledcAttachPin(aPin, tLedcChannel);
+#  endif
+    sHardwareServoPins[tChannelIndex] = aPin;
+    sHardwareServoUsedChannelMask |= (1 << tChannelIndex);
+    return true;
+}
+
+void deinitHardwareServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+#  if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+        ledcDetach(aPin);
+#  else
+        ledcWrite(HARDWARE_SERVO_FIRST_LEDC_CHANNEL + tChannelIndex, 0);
+        ledcDetachPin(aPin);
+#  endif
+        pinMode(aPin, INPUT);
+        sHardwareServoUsedChannelMask &= ~(1 << tChannelIndex);
+    }
+}
+
+void writeMicrosecondsHardwareServoPin(int aMicroseconds, uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+#  if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+        ledcWrite(aPin, getHardwareServoLedcDuty(aMicroseconds));
+#  else
+        ledcWrite(HARDWARE_SERVO_FIRST_LEDC_CHANNEL + tChannelIndex, getHardwareServoLedcDuty(aMicroseconds));
+#  endif
+    }
+}
+
+#elif defined(ARDUINO_ARCH_RP2040)
+/*
+ * The slice counter runs with the system clock divided by the smallest integer divider,
+ * for which the period fits into the 16 bit counter. For 125 MHz this is 39, giving 3.2 counts per microsecond.
+ */
+uint32_t sHardwareServoCountsPerMicrosecondShift16; // counts per microsecond * 65536
+uint8_t sHardwareServoInitializedSliceMask;
+
+bool initHardwareServoPin(uint8_t aPin) {
+    if (aPin >= NUM_BANK0_GPIOS) {
+        return false;
+    }
+    uint_fast8_t tSlice = pwm_gpio_to_slice_num(aPin);
+    uint_fast8_t tChannelIndex = (tSlice * 2) + pwm_gpio_to_channel(aPin);
+    if (tChannelIndex >= HARDWARE_SERVO_MAX_CHANNELS) {
+        return false;
+    }
+    if (sHardwareServoUsedChannelMask & (1 << tChannelIndex)) {
+        return sHardwareServoPins[tChannelIndex] == aPin; // false if PWM channel is used by the other pin (GPIO n and n + 16)
+    }
+
+    if (!(sHardwareServoInitializedSliceMask & (1 << tSlice))) {
+        uint64_t tCountsPerPeriod = ((uint64_t) clock_get_hz(clk_sys) * HARDWARE_SERVO_REFRESH_INTERVAL_MICROS) / 1000000;
+        uint32_t tDivider = (tCountsPerPeriod + 0xFFFF) / 0x10000;
+        sHardwareServoCountsPerMicrosecondShift16 = (((uint64_t) clock_get_hz(clk_sys)) << 16) / (tDivider * 1000000);
+        pwm_config tConfig = pwm_get_default_config();
+        pwm_config_set_clkdiv_int(&tConfig, tDivider);
+        pwm_config_set_wrap(&tConfig, (tCountsPerPeriod / tDivider) - 1);
+        pwm_init(tSlice, &tConfig, false);
+        pwm_set_both_levels(tSlice, 0, 0); // no pulse until first write
+        pwm_set_enabled(tSlice, true);
+        sHardwareServoInitializedSliceMask |= (1 << tSlice);
+    }
+    sHardwareServoPins[tChannelIndex] = aPin;
+    sHardwareServoUsedChannelMask |= (1 << tChannelIndex);
+    gpio_set_function(aPin, GPIO_FUNC_PWM);
+    return true;
+}
+
+void deinitHardwareServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+        pwm_set_gpio_level(aPin, 0);
+        gpio_init(aPin); // change to input
+        sHardwareServoUsedChannelMask &= ~(1 << tChannelIndex);
+    }
+}
+
+/*
+ * The new level is taken by the hardware at the next counter wrap, so a pulse is never split.
+ */
+void writeMicrosecondsHardwareServoPin(int aMicroseconds, uint8_t aPin) {
+    if (getHardwareServoChannelIndex(aPin) < HARDWARE_SERVO_MAX_CHANNELS) {
+        pwm_set_gpio_level(aPin, ((uint32_t) aMicroseconds * sHardwareServoCountsPerMicrosecondShift16 + 0x8000) >> 16);
+    }
+}
+#else // defined(ESP32)
+/*
+ * One HardwareTimer for each timer used by a servo pin
+ */
+HardwareTimer *sHardwareServoTimers[HARDWARE_SERVO_MAX_TIMERS];
+TIM_TypeDef *sHardwareServoTimerInstances[HARDWARE_SERVO_MAX_TIMERS];
+uint8_t sHardwareServoNumberOfTimers;
+uint8_t sHardwareServoTimerIndexes[HARDWARE_SERVO_MAX_CHANNELS];
+uint8_t sHardwareServoTimerChannels[HARDWARE_SERVO_MAX_CHANNELS]; // 1 to 4
+
+bool initHardwareServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+        return true; // already attached
+    }
+    PinName tPinName = digitalPinToPinName(aPin);
+    TIM_TypeDef *tTimerInstance = (TIM_TypeDef*) pinmap_peripheral(tPinName, PinMap_PWM);
+    if (tTimerInstance == NP || tTimerInstance == TIM4) {
+        return false; // no PWM pin or timer used for ServoEasing interrupt
+    }
+
+    uint_fast8_t tTimerIndex = 0;
+    for (; tTimerIndex < sHardwareServoNumberOfTimers; ++tTimerIndex) {
+        if (sHardwareServoTimerInstances[tTimerIndex] == tTimerInstance) {
+            break;
+        }
+    }
+    if (tTimerIndex >= HARDWARE_SERVO_MAX_TIMERS) {
+        return false; // increase HARDWARE_SERVO_MAX_TIMERS
+    }
+    // Take the first free channel
+    for (tChannelIndex = 0; tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS; ++tChannelIndex) {
+        if (!(sHardwareServoUsedChannelMask & (1 << tChannelIndex))) {
+            break;
+        }
+    }
+    if (tChannelIndex >= HARDWARE_SERVO_MAX_CHANNELS) {
+        return false; // all channels are in use
+    }
+
+    if (tTimerIndex == sHardwareServoNumberOfTimers) {
+        sHardwareServoTimerInstances[tTimerIndex] = tTimerInstance;
+        sHardwareServoTimers[tTimerIndex] = new HardwareTimer(tTimerInstance);
+        sHardwareServoTimers[tTimerIndex]->setOverflow(HARDWARE_SERVO_REFRESH_INTERVAL_MICROS, MICROSEC_FORMAT);
+        sHardwareServoNumberOfTimers++;
+    }
+    uint8_t tTimerChannel = STM_PIN_CHANNEL(pinmap_function(tPinName, PinMap_PWM));
+    for (uint_fast8_t i = 0; i < HARDWARE_SERVO_MAX_CHANNELS; ++i) {
+        if ((sHardwareServoUsedChannelMask & (1 << i)) && sHardwareServoTimerIndexes[i] == tTimerIndex
+                && sHardwareServoTimerChannels[i] == tTimerChannel) {
+            return false; // timer channel is used by another pin
+        }
+    }
+    HardwareTimer *tTimer = sHardwareServoTimers[tTimerIndex];
+    tTimer->setMode(tTimerChannel, TIMER_OUTPUT_COMPARE_PWM1, aPin); // this enables the preload of the compare register
+    tTimer->setCaptureCompare(tTimerChannel, 0, MICROSEC_COMPARE_FORMAT); // no pulse until first write
+    tTimer->resume();
+
+    sHardwareServoPins[tChannelIndex] = aPin;
+    sHardwareServoTimerIndexes[tChannelIndex] = tTimerIndex;
+    sHardwareServoTimerChannels[tChannelIndex] = tTimerChannel;
+    sHardwareServoUsedChannelMask |= (1 << tChannelIndex);
+    return true;
+}
+
+void deinitHardwareServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+        HardwareTimer *tTimer = sHardwareServoTimers[sHardwareServoTimerIndexes[tChannelIndex]];
+        tTimer->setCaptureCompare(sHardwareServoTimerChannels[tChannelIndex], 0, MICROSEC_COMPARE_FORMAT);
+        tTimer->setMode(sHardwareServoTimerChannels[tChannelIndex], TIMER_DISABLED);
+        pinMode(aPin, INPUT);
+        sHardwareServoUsedChannelMask &= ~(1 << tChannelIndex);
+    }
+}
+
+/*
+ * Only the preload register is written. It is transferred to the active compare register at the next update event,
+ * together with the values of all other channels of this timer.
+ */
+void writeMicrosecondsHardwareServoPin(int aMicroseconds, uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getHardwareServoChannelIndex(aPin);
+    if (tChannelIndex < HARDWARE_SERVO_MAX_CHANNELS) {
+        sHardwareServoTimers[sHardwareServoTimerIndexes[tChannelIndex]]->setCaptureCompare(sHardwareServoTimerChannels[tChannelIndex],
+                aMicroseconds, MICROSEC_COMPARE_FORMAT);
+    }
+}
+#endif // defined(ESP32)
+
+#endif // defined(ESP32) || defined(ARDUINO_ARCH_RP2040) || defined(STM32F1xx)
+#endif // _HARDWARE_SERVO_HPP
@@ -24,11 +24,12 @@
 #ifndef _LIGHTWEIGHT_SERVO_H
 #define _LIGHTWEIGHT_SERVO_H
 
-#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) \
+    || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
 
-#define VERSION_LIGHTWEIGHT_SERVO "1.1.0"
+#define VERSION_LIGHTWEIGHT_SERVO "1.2.0"
 #define VERSION_LIGHTWEIGHT_SERVO_MAJOR 1
-#define VERSION_LIGHTWEIGHT_SERVO_MINOR 1
+#define VERSION_LIGHTWEIGHT_SERVO_MINOR 2
 
 #include <stdint.h>
 
@@ -36,8 +37,59 @@
  * Activating this saves 70 bytes program space. You must then use the init functions initLightweightServoPin*() manually.
  */
 //#define DISABLE_SERVO_TIMER_AUTO_INITIALIZE
+#if !defined(ISR1_COUNT_FOR_20_MILLIS)
 #define ISR1_COUNT_FOR_20_MILLIS 40000 // you can modify this if you have servos which accept a higher rate
+#endif
 
+/*
+ * If ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE is defined, writeMicrosecondsLightweightServoPin() does not write the compare register,
+ * but only stages the value. All staged values of a timer are written by its overflow interrupt at TOP,
+ * so a new value can never split a pulse or be taken by one channel one period earlier than by the other channels.
+ * A timer overflow handler, e.g. the ServoEasing update, can be called after the staged values are written,
+ * so a frame computed in one period is output exactly at the next period.
+ * The aUpdateFast parameter is ignored, since resetting the timer counter would generate a short pulse.
+ */
+//#define ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE
+
+/*
+ * If ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION is defined, the PWM period can be shorter than the frame,
+ * i.e. the interval in which new values are computed, e.g. 5 ms servo period for a 20 ms frame.
+ * A value written by writeMicrosecondsLightweightServoPin() is then not output at once, but approached linearly at each period
+ * and reached at the end of the frame, when the next value is written. This gives smoother moves of fast digital servos
+ * without computing the easing more often, at the cost of a delay of one frame.
+ * The timer top handler is called only once per frame.
+ * The frame is set by setLightweightServoInterpolationFrame(), which is called by ServoEasing with REFRESH_INTERVAL_MICROS.
+ * The period is set by setLightweightServoRefreshRate() or by writing ICRn.
+ * Requires 9 bytes RAM per timer channel and a 32 bit division for each write.
+ * Implies ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE.
+ */
+//#define ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION) && !defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+#define ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE
+#endif
+
+/*
+ * Pin based API for all 16 bit timer channels
+ * ATmega328:      Timer1 pin 9 (A) and 10 (B)
+ * ATmega32U4:     Timer1 pin 9 (A), 10 (B) and 11 (C), Timer3 pin 5 (A)
+ * ATmega1280/2560 Timer1 pin 11 (A), 12 (B) and 13 (C), Timer3 pin 5 (A), 2 (B) and 3 (C)
+ *                 Timer4 pin 6 (A), 7 (B) and 8 (C), Timer5 pin 46 (A), 45 (B) and 44 (C)
+ * All servos of one timer share its refresh period.
+ */
+bool isLightweightServoPin(uint8_t aPin);
+bool initLightweightServoPin(uint8_t aPin); // Returns false if pin is not connected to a 16 bit timer channel
+void deinitLightweightServoPin(uint8_t aPin);
+void initLightweightServoTimer(uint8_t aTimerNumber); // Sets FastPWM mode and period, but keeps the output settings
+void writeMicrosecondsLightweightServoPin(int aMicroseconds, uint8_t aPin); // Without auto initialize!
+void setLightweightServoPulseMicrosFor0And180Degree(int aMicrosecondsForServo0Degree, int a180DegreeValue);
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+void setLightweightServoTimerTopHandler(uint8_t aTimerNumber, void (*aTimerTopHandler)()); // NULL disables the handler
+#endif
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+void setLightweightServoInterpolationFrame(unsigned int aFrameMicroseconds); // 0 -> no interpolation
+#endif
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
 /*
  * Lightweight servo library
  * Uses timer1 and Pin 9 + 10 as output
@@ -48,7 +100,6 @@ void initLightweightServoPin10();   // Disables Pin 9!
 void initLightweightServoPin9_10(bool aUsePin9, bool aUsePin10);
 void deinitLightweightServoPin9_10(bool aUsePin9, bool aUsePin10);
 
-void setLightweightServoPulseMicrosFor0And180Degree(int aMicrosecondsForServo0Degree, int a180DegreeValue);
 void setLightweightServoRefreshRate(unsigned int aRefreshPeriodMicroseconds);
 
 int writeLightweightServo(int aDegree, bool aUsePin9, bool aUpdateFast = false);
@@ -61,14 +112,22 @@ void writeMicroseconds9Direct(int aMicroseconds);
 void write10(int aDegree, bool aUpdateFast = false); // setLightweightServoPulsePin10 Channel B
 void writeMicroseconds10(int aMicroseconds, bool aUpdateFast = false);
 void writeMicroseconds10Direct(int aMicroseconds);
+#endif // AVR_ATmega328
 
 // convenience functions
 int DegreeToMicrosecondsLightweightServo(int aDegree);
 int MicrosecondsToDegreeLightweightServo(int aMicroseconds);
 
-#endif // AVR_ATmega328
+#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) ...
 
 /*
+ * Version 1.3.0 - work in progress
+ * - ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION and function setLightweightServoInterpolationFrame().
+ *
+ * Version 1.2.0
+ * - Pin based functions for all 16 bit timer channels of ATmega328, ATmega32U4 and ATmega1280/2560.
+ * - ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE and function setLightweightServoTimerTopHandler().
+ *
  * Version 1.1.0 - 11/2020
  * - Improved API.
  */
@@ -29,7 +29,8 @@
 #ifndef _LIGHTWEIGHT_SERVO_HPP
 #define _LIGHTWEIGHT_SERVO_HPP
 
-#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) \
+    || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
 #include "LightweightServo.h"
 
 /*
@@ -40,6 +41,274 @@
 int sMicrosecondsForServo0Degree = 544;
 int sMicrosecondsForServo180Degree = 2400;
 
+/*
+ * The registers of a 16 bit timer. The OCRnA, OCRnB and OCRnC registers are located at consecutive addresses.
+ * The bits of TCCRnA and TCCRnB have the same positions for all 16 bit timers, so we use the timer 1 names.
+ */
+struct LightweightServoTimerStruct {
+    uint8_t TimerNumber;
+    volatile uint8_t *TCCRnA;
+    volatile uint8_t *TCCRnB;
+    volatile uint16_t *ICRn;
+    volatile uint16_t *OCRnA;
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+    volatile uint8_t *TIMSKn;
+#endif
+};
+struct LightweightServoChannelStruct {
+    uint8_t Pin;
+    uint8_t TimerIndex; // Index in LightweightServoTimers
+    uint8_t Channel;    // 0 -> A, 1 -> B, 2 -> C
+};
+
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+#define LIGHTWEIGHT_SERVO_TIMER(n) { n, &TCCR##n##A, &TCCR##n##B, &ICR##n, &OCR##n##A, &TIMSK##n }
+#else
+#define LIGHTWEIGHT_SERVO_TIMER(n) { n, &TCCR##n##A, &TCCR##n##B, &ICR##n, &OCR##n##A }
+#endif
+#if defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+const LightweightServoTimerStruct LightweightServoTimers[] PROGMEM = { LIGHTWEIGHT_SERVO_TIMER(1), LIGHTWEIGHT_SERVO_TIMER(3),
+        LIGHTWEIGHT_SERVO_TIMER(4), LIGHTWEIGHT_SERVO_TIMER(5) };
+const LightweightServoChannelStruct LightweightServoChannels[] PROGMEM = { { 11, 0, 0 }, { 12, 0, 1 }, { 13, 0, 2 }, { 5, 1, 0 },
+        { 2, 1, 1 }, { 3, 1, 2 }, { 6, 2, 0 }, { 7, 2, 1 }, { 8, 2, 2 }, { 46, 3, 0 }, { 45, 3, 1 }, { 44, 3, 2 } };
+#elif defined(__AVR_ATmega32U4__)
+const LightweightServoTimerStruct LightweightServoTimers[] PROGMEM = { LIGHTWEIGHT_SERVO_TIMER(1), LIGHTWEIGHT_SERVO_TIMER(3) };
+const LightweightServoChannelStruct LightweightServoChannels[] PROGMEM = { { 9, 0, 0 }, { 10, 0, 1 }, { 11, 0, 2 }, { 5, 1, 0 } };
+#else
+const LightweightServoTimerStruct LightweightServoTimers[] PROGMEM = { LIGHTWEIGHT_SERVO_TIMER(1) };
+const LightweightServoChannelStruct LightweightServoChannels[] PROGMEM = { { 9, 0, 0 }, { 10, 0, 1 } };
+#endif
+#define LIGHTWEIGHT_SERVO_NUMBER_OF_TIMERS      (sizeof(LightweightServoTimers) / sizeof(LightweightServoTimerStruct))
+#define LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS    (sizeof(LightweightServoChannels) / sizeof(LightweightServoChannelStruct))
+
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+uint16_t sLightweightServoStagedValues[LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS]; // Compare register values
+volatile uint16_t sLightweightServoStagedChannelMask; // Bit n is set if sLightweightServoStagedValues[n] is not yet written
+uint8_t sLightweightServoTimerNumberOfTopHandler;
+void (*volatile sLightweightServoTimerTopHandler)() = NULL;
+#endif
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+unsigned int sLightweightServoInterpolationFrameMicros = 0;
+uint8_t sLightweightServoPeriodCounterOfTopHandler; // Periods since the last call of the top handler
+/*
+ * The compare values with 8 bit fraction, the step per period and the periods until sLightweightServoStagedValues[] is reached
+ */
+uint32_t sLightweightServoInterpolatedValues[LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS]; // 0 -> not yet written, take next value directly
+int32_t sLightweightServoInterpolationSteps[LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS];
+uint8_t sLightweightServoInterpolationPeriodsLeft[LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS];
+#endif
+
+/*
+ * @return Index in LightweightServoChannels or LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS if pin is not connected to a timer channel
+ */
+uint_fast8_t getLightweightServoChannelIndex(uint8_t aPin) {
+    uint_fast8_t tIndex = 0;
+    for (; tIndex < LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS; ++tIndex) {
+        if (pgm_read_byte(&LightweightServoChannels[tIndex].Pin) == aPin) {
+            break;
+        }
+    }
+    return tIndex;
+}
+
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+/*
+ * @return Number of periods of the timer in one interpolation frame, at least 1
+ */
+uint_fast8_t getLightweightServoPeriodsPerFrame(uint_fast8_t aTimerIndex) {
+    uint16_t tPeriodMicros = *((volatile uint16_t*) pgm_read_word(&LightweightServoTimers[aTimerIndex].ICRn)) / 2;
+    if (tPeriodMicros == 0 || sLightweightServoInterpolationFrameMicros <= tPeriodMicros) {
+        return 1;
+    }
+    unsigned int tPeriodsPerFrame = sLightweightServoInterpolationFrameMicros / tPeriodMicros;
+    return (tPeriodsPerFrame > UINT8_MAX) ? UINT8_MAX : tPeriodsPerFrame;
+}
+
+/*
+ * A frame of e.g. 20000 us and a period of 5000 us interpolates each written value over 4 periods
+ * and calls the timer top handler every 4th period.
+ * @param aFrameMicroseconds Interval of the writes, 0 disables the interpolation
+ */
+void setLightweightServoInterpolationFrame(unsigned int aFrameMicroseconds) {
+    sLightweightServoInterpolationFrameMicros = aFrameMicroseconds;
+}
+#endif
+
+bool isLightweightServoPin(uint8_t aPin) {
+    return getLightweightServoChannelIndex(aPin) < LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS;
+}
+
+/*
+ * Set FastPWM mode with TOP (20 ms) determined by ICRn and prescaler 8, if not already done.
+ * The Compare Output mode bits of the other channels and the ICNC1 bit used by ServoEasing are kept.
+ */
+void initLightweightServoTimerWithIndex(uint_fast8_t aTimerIndex) {
+    volatile uint8_t *tTCCRnA = (volatile uint8_t*) pgm_read_word(&LightweightServoTimers[aTimerIndex].TCCRnA);
+    volatile uint8_t *tTCCRnB = (volatile uint8_t*) pgm_read_word(&LightweightServoTimers[aTimerIndex].TCCRnB);
+    if ((*tTCCRnB & ~_BV(ICNC1)) != (_BV(WGM13) | _BV(WGM12) | _BV(CS11))) {
+        *tTCCRnA = (*tTCCRnA & (_BV(COM1A1) | _BV(COM1B1) | (_BV(COM1B1) >> 2))) | _BV(WGM11); // keep COMnA1, COMnB1 and COMnC1
+        *tTCCRnB = _BV(WGM13) | _BV(WGM12) | _BV(CS11);
+        *((volatile uint16_t*) pgm_read_word(&LightweightServoTimers[aTimerIndex].ICRn)) = ISR1_COUNT_FOR_20_MILLIS; // set period to 20 ms
+    }
+}
+
+/*
+ * @param aTimerNumber 1, 3, 4 or 5. Unsupported timer numbers are ignored.
+ */
+void initLightweightServoTimer(uint8_t aTimerNumber) {
+    for (uint_fast8_t tTimerIndex = 0; tTimerIndex < LIGHTWEIGHT_SERVO_NUMBER_OF_TIMERS; ++tTimerIndex) {
+        if (pgm_read_byte(&LightweightServoTimers[tTimerIndex].TimerNumber) == aTimerNumber) {
+            initLightweightServoTimerWithIndex(tTimerIndex);
+        }
+    }
+}
+
+/*
+ * Initializes the timer of the pin, if not already done, and enables the non-inverting Compare Output mode of the pin.
+ * Attention - the pin is set to OUTPUT here!
+ * @return false if pin is not connected to a 16 bit timer channel
+ */
+bool initLightweightServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getLightweightServoChannelIndex(aPin);
+    if (tChannelIndex >= LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS) {
+        return false;
+    }
+    uint_fast8_t tTimerIndex = pgm_read_byte(&LightweightServoChannels[tChannelIndex].TimerIndex);
+    uint_fast8_t tChannel = pgm_read_byte(&LightweightServoChannels[tChannelIndex].Channel);
+    initLightweightServoTimerWithIndex(tTimerIndex);
+
+    volatile uint16_t *tOCRnA = (volatile uint16_t*) pgm_read_word(&LightweightServoTimers[tTimerIndex].OCRnA);
+    tOCRnA[tChannel] = UINT16_MAX;  // Set counter > ICRn here, to avoid output signal generation.
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+    sLightweightServoInterpolatedValues[tChannelIndex] = 0; // do not interpolate from the value before the last deinit
+#endif
+    pinMode(aPin, OUTPUT);
+    volatile uint8_t *tTCCRnA = (volatile uint8_t*) pgm_read_word(&LightweightServoTimers[tTimerIndex].TCCRnA);
+    *tTCCRnA |= _BV(COM1A1) >> (2 * tChannel); // COM1A1, COM1B1 or COM1C1 -> non-inverting Compare Output mode
+    return true;
+}
+
+void deinitLightweightServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getLightweightServoChannelIndex(aPin);
+    if (tChannelIndex < LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS) {
+        uint_fast8_t tTimerIndex = pgm_read_byte(&LightweightServoChannels[tChannelIndex].TimerIndex);
+        volatile uint8_t *tTCCRnA = (volatile uint8_t*) pgm_read_word(&LightweightServoTimers[tTimerIndex].TCCRnA);
+        *tTCCRnA &= ~(_BV(COM1A1) >> (2 * pgm_read_byte(&LightweightServoChannels[tChannelIndex].Channel)));
+        pinMode(aPin, INPUT);
+    }
+}
+
+/*
+ * Without auto initialize! Call initLightweightServoPin() before.
+ */
+void writeMicrosecondsLightweightServoPin(int aMicroseconds, uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getLightweightServoChannelIndex(aPin);
+    if (tChannelIndex < LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS) {
+        uint_fast8_t tTimerIndex = pgm_read_byte(&LightweightServoChannels[tChannelIndex].TimerIndex);
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+#  if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+        uint_fast8_t tPeriodsPerFrame = getLightweightServoPeriodsPerFrame(tTimerIndex);
+#  endif
+        uint8_t tSREG = SREG;
+        cli(); // the value and mask are read by the timer overflow interrupt
+        sLightweightServoStagedValues[tChannelIndex] = aMicroseconds * 2; // resolution is 1/2 of microsecond
+#  if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+        uint32_t tTargetValue = (uint32_t) (aMicroseconds * 2) << 8;
+        if (sLightweightServoInterpolatedValues[tChannelIndex] == 0) {
+            tPeriodsPerFrame = 1; // first value after init
+        }
+        // Start at the value of the last period, which may be between the last 2 written values
+        sLightweightServoInterpolationSteps[tChannelIndex] = ((int32_t) (tTargetValue
+                - sLightweightServoInterpolatedValues[tChannelIndex])) / (int_fast16_t) tPeriodsPerFrame;
+        sLightweightServoInterpolationPeriodsLeft[tChannelIndex] = tPeriodsPerFrame;
+#  endif
+        sLightweightServoStagedChannelMask |= (1 << tChannelIndex);
+        SREG = tSREG;
+        *((volatile uint8_t*) pgm_read_word(&LightweightServoTimers[tTimerIndex].TIMSKn)) |= _BV(TOIE1); // enable overflow interrupt
+#else
+        volatile uint16_t *tOCRnA = (volatile uint16_t*) pgm_read_word(&LightweightServoTimers[tTimerIndex].OCRnA);
+        tOCRnA[pgm_read_byte(&LightweightServoChannels[tChannelIndex].Channel)] = aMicroseconds * 2; // resolution is 1/2 of microsecond
+#endif
+    }
+}
+
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+/*
+ * The handler is called by the overflow interrupt of the timer after the staged values are written, i.e. once per period.
+ * The overflow interrupt is enabled here, and stays enabled after setting NULL.
+ * @param aTimerNumber 1, 3, 4 or 5
+ */
+void setLightweightServoTimerTopHandler(uint8_t aTimerNumber, void (*aTimerTopHandler)()) {
+    for (uint_fast8_t tTimerIndex = 0; tTimerIndex < LIGHTWEIGHT_SERVO_NUMBER_OF_TIMERS; ++tTimerIndex) {
+        if (pgm_read_byte(&LightweightServoTimers[tTimerIndex].TimerNumber) == aTimerNumber) {
+            sLightweightServoTimerNumberOfTopHandler = aTimerNumber;
+            sLightweightServoTimerTopHandler = aTimerTopHandler;
+            *((volatile uint8_t*) pgm_read_word(&LightweightServoTimers[tTimerIndex].TIMSKn)) |= _BV(TOIE1);
+        }
+    }
+}
+
+/*
+ * Called by the overflow interrupt at TOP. The compare registers are double buffered and take the values at the following BOTTOM,
+ * so all channels of the timer change at the same period.
+ * For ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION, the staged mask bit of a channel is kept until the interpolation is done.
+ */
+void handleLightweightServoTimerTop(uint_fast8_t aTimerIndex) {
+    volatile uint16_t *tOCRnA = (volatile uint16_t*) pgm_read_word(&LightweightServoTimers[aTimerIndex].OCRnA);
+    uint16_t tStagedChannelMask = sLightweightServoStagedChannelMask;
+    for (uint_fast8_t tChannelIndex = 0; tChannelIndex < LIGHTWEIGHT_SERVO_NUMBER_OF_CHANNELS; ++tChannelIndex) {
+        if ((tStagedChannelMask & (1 << tChannelIndex))
+                && pgm_read_byte(&LightweightServoChannels[tChannelIndex].TimerIndex) == aTimerIndex) {
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+            if (sLightweightServoInterpolationPeriodsLeft[tChannelIndex] > 1) {
+                sLightweightServoInterpolationPeriodsLeft[tChannelIndex]--;
+                uint32_t tInterpolatedValue = sLightweightServoInterpolatedValues[tChannelIndex]
+                        + sLightweightServoInterpolationSteps[tChannelIndex];
+                sLightweightServoInterpolatedValues[tChannelIndex] = tInterpolatedValue;
+                tOCRnA[pgm_read_byte(&LightweightServoChannels[tChannelIndex].Channel)] = tInterpolatedValue >> 8;
+                continue;
+            }
+            // Last period of the frame, take the exact value
+            sLightweightServoInterpolatedValues[tChannelIndex] = (uint32_t) sLightweightServoStagedValues[tChannelIndex] << 8;
+#endif
+            tOCRnA[pgm_read_byte(&LightweightServoChannels[tChannelIndex].Channel)] = sLightweightServoStagedValues[tChannelIndex];
+            tStagedChannelMask &= ~(1 << tChannelIndex);
+        }
+    }
+    sLightweightServoStagedChannelMask = tStagedChannelMask;
+    if (sLightweightServoTimerTopHandler != NULL
+            && pgm_read_byte(&LightweightServoTimers[aTimerIndex].TimerNumber) == sLightweightServoTimerNumberOfTopHandler) {
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION)
+        sLightweightServoPeriodCounterOfTopHandler++;
+        if (sLightweightServoPeriodCounterOfTopHandler < getLightweightServoPeriodsPerFrame(aTimerIndex)) {
+            return; // call handler only once per frame
+        }
+        sLightweightServoPeriodCounterOfTopHandler = 0;
+#endif
+        sLightweightServoTimerTopHandler();
+    }
+}
+
+ISR(TIMER1_OVF_vect) {
+    handleLightweightServoTimerTop(0);
+}
+#  if defined(__AVR_ATmega32U4__) || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+ISR(TIMER3_OVF_vect) {
+    handleLightweightServoTimerTop(1);
+}
+#  endif
+#  if defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+ISR(TIMER4_OVF_vect) {
+    handleLightweightServoTimerTop(2);
+}
+ISR(TIMER5_OVF_vect) {
+    handleLightweightServoTimerTop(3);
+}
+#  endif
+#endif // defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+
 /*
  * Use 16 bit timer1 for generating 2 servo signals entirely by hardware without any interrupts.
  * Use FastPWM mode and generate pulse at start of the 20 ms period
@@ -139,6 +408,10 @@ void writeMicrosecondsLightweightServo(int aMicroseconds, bool aUsePin9, bool aU
         initLightweightServoPin9_10(aUsePin9, !aUsePin9);
     }
 #endif
+#if defined(ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE)
+    (void) aUpdateFast; // restarting the period would break the double buffering
+    writeMicrosecondsLightweightServoPin(aMicroseconds, aUsePin9 ? 9 : 10);
+#else
     // since the resolution is 1/2 of microsecond
     aMicroseconds *= 2;
     if (aUpdateFast) {
@@ -153,6 +426,7 @@ void writeMicrosecondsLightweightServo(int aMicroseconds, bool aUsePin9, bool aU
     } else {
         OCR1B = aMicroseconds;
     }
+#endif
 }
 
 /*
@@ -162,6 +436,8 @@ void writeMicrosecondsLightweightServo(int aMicroseconds, bool aUsePin9, bool aU
 void setLightweightServoRefreshRate(unsigned int aRefreshPeriodMicroseconds) {
     ICR1 = aRefreshPeriodMicroseconds * 2;
 }
+#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+
 /*
  * Set the mapping pulse width values for 0 and 180 degree
  */
@@ -170,6 +446,7 @@ void setLightweightServoPulseMicrosFor0And180Degree(int aMicrosecondsForServo0De
     sMicrosecondsForServo180Degree = aMicrosecondsForServo180Degree;
 }
 
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
 /*
  * Pin 9 / Channel A. If value is below 180 then assume degree, otherwise assume microseconds
  */
@@ -205,6 +482,7 @@ void writeMicroseconds10(int aMicroseconds, bool aUpdateFast) {
 void writeMicroseconds10Direct(int aMicroseconds) {
     OCR1B = aMicroseconds * 2;
 }
+#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
 
 /*
  * Conversion functions
@@ -217,5 +495,5 @@ int MicrosecondsToDegreeLightweightServo(int aMicroseconds) {
     return map(aMicroseconds, sMicrosecondsForServo0Degree, sMicrosecondsForServo180Degree, 0, 180);
 }
 
-#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) ...
 #endif // _LIGHTWEIGHT_SERVO_HPP
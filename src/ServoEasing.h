@@ -59,8 +59,11 @@
 //#define USE_SERVO_LIB
 
 /*
- * If you have only one or two servos at pin 9 and/or 10 and an ATmega328, then you can save program memory by defining symbol `USE_LEIGHTWEIGHT_SERVO_LIB`.
- * This saves 742 bytes program memory and 42 bytes RAM.
+ * If you have an ATmega328, ATmega32U4 or ATmega1280/2560 and your servos are at the pins of the 16 bit timer channels,
+ * then you can save program memory by defining symbol `USE_LEIGHTWEIGHT_SERVO_LIB`.
+ * These are pin 9 and 10 for ATmega328, pin 9, 10, 11 and 5 for ATmega32U4 (Leonardo)
+ * and pin 11, 12, 13, 5, 2, 3, 6, 7, 8, 46, 45 and 44 for ATmega1280/2560 (Mega), see LightweightServo.h.
+ * This saves 742 bytes program memory and 42 bytes RAM on an ATmega328.
  * Using Lightweight Servo library (or PCA9685 servo expander) makes the servo pulse generating immune
  * to other libraries blocking interrupts for a longer time like SoftwareSerial, Adafruit_NeoPixel and DmxSimple.
  * If not using the Arduino IDE take care that Arduino Servo library sources are not compiled / included in the project.
@@ -68,8 +71,60 @@
  */
 //#define USE_LEIGHTWEIGHT_SERVO_LIB
 
-#if defined(USE_LEIGHTWEIGHT_SERVO_LIB) && !(defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__))
-#error USE_LEIGHTWEIGHT_SERVO_LIB can only be activated for the Atmega328 CPU
+#if defined(USE_LEIGHTWEIGHT_SERVO_LIB) && !(defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) \
+    || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__))
+#error USE_LEIGHTWEIGHT_SERVO_LIB can only be activated for the ATmega328, ATmega32U4 and ATmega1280/2560 CPU
+#endif
+
+/*
+ * If you have an ATmega328, ATmega32U4 or ATmega1280/2560 and want to use up to 16 servos at arbitrary pins,
+ * you can define USE_SORTED_SOFT_SERVO_LIB to replace the Arduino Servo library by the SortedSoftServo library.
+ * It uses timer1 and sets all pins high at once at the start of a period, then sets them low in the order of their sorted pulse width.
+ * Pins of one port with equal pulse width are set low by one port write, which requires less interrupt time and has less jitter
+ * than the 2 interrupts per servo of the Arduino Servo library. See SortedSoftServo.h.
+ * Use of SortedSoftServo library disables use of regular servo library.
+ */
+//#define USE_SORTED_SOFT_SERVO_LIB
+
+#if defined(USE_SORTED_SOFT_SERVO_LIB) && !(defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) \
+    || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__))
+#error USE_SORTED_SOFT_SERVO_LIB can only be activated for the ATmega328, ATmega32U4 and ATmega1280/2560 CPU
+#endif
+#if defined(USE_SORTED_SOFT_SERVO_LIB) && defined(USE_LEIGHTWEIGHT_SERVO_LIB)
+#error USE_SORTED_SOFT_SERVO_LIB and USE_LEIGHTWEIGHT_SERVO_LIB cannot be activated together, since both use timer1
+#endif
+
+/*
+ * If you have an ESP32, RP2040 or STM32F1, you can define USE_HARDWARE_SERVO_LIB to replace the ESP32Servo / Servo library by the HardwareServo library.
+ * The pulses are then generated entirely by the LEDC peripheral of the ESP32, the PWM slices of the RP2040
+ * or the timer channels of the STM32 with a resolution of 0.3 us.
+ * A servo write only sets the new compare value, which is taken at the start of the next period. See HardwareServo.h.
+ * Use of HardwareServo library disables use of regular servo library.
+ */
+//#define USE_HARDWARE_SERVO_LIB
+
+#if defined(USE_HARDWARE_SERVO_LIB) && !(defined(ESP32) || defined(ARDUINO_ARCH_RP2040) || defined(STM32F1xx))
+#error USE_HARDWARE_SERVO_LIB can only be activated for ESP32, RP2040 and STM32F1xx
+#endif
+
+/*
+ * If ENABLE_SIMULATION_MODE is defined, no servo library and no timer is used.
+ * Every value written by _writeMicrosecondsOrUnits() is printed as line "<milliseconds>;<servo index>;<microseconds>"
+ * to the Print object set by setSimulationTraceOutput(). A value of 0 means, that the signal is switched off.
+ * The time is the virtual clock of ENABLE_FRAME_COUNTER_TIME_BASE, which is advanced by each updateAllServos().
+ * The servo interrupt is emulated by areInterruptsActive() and by runSimulation(), which replaces delay() in the sequence to test.
+ * Thus a sequence runs much faster than real time and gives the same trace at each run, which can be compared with a golden trace by diff.
+ * It can be compiled for the host with extras/HostSimulation/Arduino.h, see extras/HostSimulation/ServoEasingHostSimulation.cpp.
+ */
+//#define ENABLE_SIMULATION_MODE
+#if defined(ENABLE_SIMULATION_MODE)
+#  if defined(USE_PCA9685_SERVO_EXPANDER) || defined(USE_LEIGHTWEIGHT_SERVO_LIB) || defined(USE_SORTED_SOFT_SERVO_LIB) \
+    || defined(USE_HARDWARE_SERVO_LIB) || defined(ENABLE_ESP32_SERVO_TASK) || defined(ENABLE_RP2040_CORE1_SERVO_ENGINE)
+#error ENABLE_SIMULATION_MODE replaces the servo library and the servo timer, do not use it together with another servo library or servo task
+#  endif
+#  if !defined(ENABLE_FRAME_COUNTER_TIME_BASE)
+#define ENABLE_FRAME_COUNTER_TIME_BASE // The virtual clock
+#  endif
 #endif
 
 /*
@@ -82,15 +137,47 @@
 __attribute__((weak)) extern void handleServoTimerInterrupt();
 #endif
 
-#if !( defined(__AVR__) || defined(ESP8266) || defined(ESP32) || defined(STM32F1xx) || defined(__STM32F1__) || defined(__SAM3X8E__) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_APOLLO3) || defined(ARDUINO_ARCH_MBED) || defined(ARDUINO_ARCH_RP2040) || defined(TEENSYDUINO))
+#if !defined(ENABLE_SIMULATION_MODE) && !( defined(__AVR__) || defined(ESP8266) || defined(ESP32) || defined(STM32F1xx) || defined(__STM32F1__) || defined(__SAM3X8E__) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_APOLLO3) || defined(ARDUINO_ARCH_MBED) || defined(ARDUINO_ARCH_RP2040) || defined(TEENSYDUINO))
 #warning No periodic timer support existent (or known) for this platform. Only blocking functions and simple example will run!
 #endif
 
+/*
+ * If ENABLE_ESP8266_HARDWARE_TIMER is defined, the frames of an ESP8266 are not timed by the Ticker, which is a software timer
+ * of the SDK and is delayed by WiFi activity, but by the auto reloaded hardware timer1 interrupt.
+ * The easing code and the floating point functions are in flash, which must not be executed in an interrupt,
+ * so the interrupt in IRAM only signals the frame. The frame is computed and sent by a function, which is scheduled
+ * by schedule_recurrent_function_us() and therefore called by the ESP8266 core after each loop() and in yield() and delay().
+ * So do not block loop() longer than one refresh interval without calling yield().
+ * Timer1 is used by the waveform generator of the ESP8266 core, i.e. by Servo.h, analogWrite() and tone(),
+ * so this is only available for servos at a PCA9685 expander without USE_SERVO_LIB.
+ */
+//#define ENABLE_ESP8266_HARDWARE_TIMER
+#if defined(ENABLE_ESP8266_HARDWARE_TIMER)
+#  if !defined(ESP8266)
+#undef ENABLE_ESP8266_HARDWARE_TIMER
+#  elif !defined(USE_PCA9685_SERVO_EXPANDER) || defined(USE_SERVO_LIB)
+#warning ENABLE_ESP8266_HARDWARE_TIMER requires USE_PCA9685_SERVO_EXPANDER without USE_SERVO_LIB, since timer1 is used by Servo.h. The Ticker is used instead.
+#undef ENABLE_ESP8266_HARDWARE_TIMER
+#  endif
+#endif
+
 /*
  * Include of the appropriate Servo.h file
  */
 #if !defined(USE_PCA9685_SERVO_EXPANDER) || defined(USE_SERVO_LIB)
-#  if defined(ESP32)
+#  if defined(ENABLE_SIMULATION_MODE)
+// No servo library, the values are printed by recordSimulatedWrite()
+
+#  elif defined(USE_HARDWARE_SERVO_LIB)
+#    if !defined(HARDWARE_SERVO_REFRESH_INTERVAL_MICROS)
+#define HARDWARE_SERVO_REFRESH_INTERVAL_MICROS REFRESH_INTERVAL_MICROS
+#    endif
+#  include "HardwareServo.h"
+#    if !defined(MAX_EASING_SERVOS)
+#    define MAX_EASING_SERVOS HARDWARE_SERVO_MAX_CHANNELS
+#    endif
+
+#  elif defined(ESP32)
 // This does not work in Arduino IDE for step "Generating function prototypes..."
 //#    if ! __has_include("ESP32Servo.h")
 //#error This ServoEasing library requires the "ESP32Servo" library for running on an ESP32. Please install it via the Arduino library manager.
@@ -102,13 +189,30 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 
 #  else // defined(ESP32)
 #    if defined(USE_LEIGHTWEIGHT_SERVO_LIB)
+#      if !defined(ISR1_COUNT_FOR_20_MILLIS)
+#define ISR1_COUNT_FOR_20_MILLIS (REFRESH_INTERVAL_MICROS * 2) // Timer 1 runs with 2 MHz
+#      endif
 #  include "LightweightServo.h"
 #      if !defined(MAX_EASING_SERVOS)
+#        if defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+#    define MAX_EASING_SERVOS 12 // number of 16 bit timer channels
+#        elif defined(__AVR_ATmega32U4__)
+#    define MAX_EASING_SERVOS 4
+#        else
 #    define MAX_EASING_SERVOS 2 // default value for UNO etc.
+#        endif
+#      endif
+#    elif defined(USE_SORTED_SOFT_SERVO_LIB)
+#      if !defined(SORTED_SOFT_SERVO_REFRESH_INTERVAL_MICROS)
+#define SORTED_SOFT_SERVO_REFRESH_INTERVAL_MICROS REFRESH_INTERVAL_MICROS
+#      endif
+#  include "SortedSoftServo.h"
+#      if !defined(MAX_EASING_SERVOS)
+#    define MAX_EASING_SERVOS SORTED_SOFT_SERVO_MAX_CHANNELS
 #      endif
 #    else
 #   include <Servo.h>
-#    endif // !defined(USE_LEIGHTWEIGHT_SERVO_LIB)
+#    endif // defined(USE_LEIGHTWEIGHT_SERVO_LIB)
 #  endif // defined(ESP32)
 #endif // defined(USE_SERVO_LIB)
 
@@ -124,16 +228,177 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 #  endif // defined(USE_PCA9685_SERVO_EXPANDER)
    #include <Wire.h>
 // PCA9685 works with up to 1 MHz I2C frequency
-#  if defined(ESP32)
+#  if defined(ESP32) && !defined(ENABLE_PCA9685_DEFERRED_TRANSFER) && !defined(ENABLE_ESP32_SERVO_TASK)
 // The ESP32 I2C interferes with the Ticker / Timer library used.
 // Even with 100 kHz clock we have some dropouts / NAK's because of sending address again instead of first data.
 #    define I2C_CLOCK_FREQUENCY 100000 // 200000 does not work for my ESP32 module together with the timer even with external pullups :-(
-#  elif defined(ESP8266)
+#  elif defined(ESP8266) || defined(ESP32)
 #    define I2C_CLOCK_FREQUENCY 400000 // 400000 is the maximum for 80 MHz clocked ESP8266 (I measured real 330000 Hz for this setting)
 #  else
 #    define I2C_CLOCK_FREQUENCY 800000 // 1000000 does not work for my Arduino Nano, maybe because of parasitic breadboard capacities
 #  endif
+
+/*
+ * If ENABLE_PCA9685_FRAME_COMMIT is defined, updateAllServos() does not send each new servo value with its own I2C transmission.
+ * The values are only staged in a shadow buffer for each PCA9685 board and are sent at the end of the frame by flushPCA9685FrameBuffers().
+ * Consecutive changed channels are sent as one auto increment transmission, which saves address, register and start/stop overhead
+ * for each additional channel. This is required, if you want to move more than 16 servos at a 20 ms refresh interval.
+ * Requires 68 bytes additional RAM per PCA9685 board.
+ */
+//#define ENABLE_PCA9685_FRAME_COMMIT
+/*
+ * If ENABLE_PCA9685_DEFERRED_TRANSFER is defined, updateAllServos() and therefore the servo timer interrupt only stage the values
+ * and do no I2C transfer at all, which reduces the interrupt time from milliseconds to microseconds.
+ * You must then call transferStagedPCA9685Frames() in your loop, which sends all values staged since its last call.
+ * This is also done by isMovingAndCallYield() and areInterruptsActive(), and by updateAllServos() if not called by interrupt.
+ * If it is called less often than once per frame, the frames are merged and only the latest values are sent.
+ * isPCA9685FrameTransferPending() returns true as long as a staged frame is not yet sent.
+ * On ESP32, the I2C is no longer disturbed by the Ticker and runs with 400 kHz.
+ * Implies ENABLE_PCA9685_FRAME_COMMIT.
+ */
+//#define ENABLE_PCA9685_DEFERRED_TRANSFER
+#  if defined(ENABLE_PCA9685_DEFERRED_TRANSFER) && !defined(ENABLE_PCA9685_FRAME_COMMIT)
+#define ENABLE_PCA9685_FRAME_COMMIT
+#  endif
+/*
+ * If ENABLE_PCA9685_RESET_RECOVERY is defined, the shadow buffer of each registered PCA9685 board always contains all 16 channels,
+ * starting with the power on values at registration. checkPCA9685ExpandersForReset() reads the MODE1 register of the next board.
+ * If a brown out or a glitch has reset the board, MODE1 has its power on value with SLEEP set, the outputs are off and the servos are limp.
+ * Then the board is initialized again and all 16 channels are restored from the shadow buffer with PCA9685_MAX_CHANNELS_PER_TRANSMISSION
+ * channels per auto increment transmission, while the oscillator is still sleeping. So all outputs restart together with their last values.
+ * Call checkPCA9685ExpandersForReset() e.g. every 100 ms in loop() if ENABLE_PCA9685_DEFERRED_TRANSFER is defined,
+ * or by a frame job of ENABLE_FRAME_SCHEDULER, otherwise the servo interrupt may access the I2C bus at the same time.
+ * getNumberOfPCA9685Recoveries() returns the number of boards restored since boot.
+ * Implies ENABLE_PCA9685_FRAME_COMMIT.
+ */
+//#define ENABLE_PCA9685_RESET_RECOVERY
+#  if defined(ENABLE_PCA9685_RESET_RECOVERY) && !defined(ENABLE_PCA9685_FRAME_COMMIT)
+#define ENABLE_PCA9685_FRAME_COMMIT
+#  endif
+/*
+ * If ENABLE_PCA9685_PARALLEL_BUSES is defined, flushPCA9685FrameBuffers() of an ESP32 sends the staged values for the boards
+ * of the first registered bus (e.g. Wire) itself, while a FreeRTOS helper task sends the values for the boards of all other buses
+ * (e.g. Wire1) at the same time. The ESP32 Wire waits for the end of a transfer by a semaphore, so the transfers of both
+ * I2C controllers overlap even if both tasks run on the same core. The frame I2C time is then determined by the bus with the
+ * most changed channels, e.g. 64 servos on 4 boards, 2 boards on each bus, take the time of 32 servos.
+ * The helper task is created at the first flush with boards at more than one bus and requires PCA9685_BUS_TASK_STACK_SIZE bytes RAM.
+ * The Arduino Wire library of the other platforms has no asynchronous transfer, so the option is ignored there.
+ * Implies ENABLE_PCA9685_FRAME_COMMIT.
+ */
+//#define ENABLE_PCA9685_PARALLEL_BUSES
+#  if defined(ENABLE_PCA9685_PARALLEL_BUSES) && defined(ESP32) && !defined(USE_SOFT_I2C_MASTER) // else it is undefined below
+#    if !defined(ENABLE_PCA9685_FRAME_COMMIT)
+#define ENABLE_PCA9685_FRAME_COMMIT
+#    endif
+#    if !defined(PCA9685_BUS_TASK_CORE)
+#define PCA9685_BUS_TASK_CORE               1 // The core of loop(). The Ticker and the servo task run on core 0
+#    endif
+#    if !defined(PCA9685_BUS_TASK_PRIORITY)
+#define PCA9685_BUS_TASK_PRIORITY           10 // Above loop(), which has priority 1
+#    endif
+#    if !defined(PCA9685_BUS_TASK_STACK_SIZE)
+#define PCA9685_BUS_TASK_STACK_SIZE         2048 // bytes
+#    endif
+#  endif
+/*
+ * If ENABLE_SOFT_I2C_INTERRUPT_TRANSFER is defined together with USE_SOFT_I2C_MASTER on an AVR, setPWM() and flushPCA9685FrameBuffers()
+ * do not wait for the I2C bus, they only copy the transmission to the I2C transfer queue by enqueueI2CTransfer().
+ * The queue is sent in the background by the TWI interrupt, one byte per interrupt, so the servo interrupt is not blocked by the bus.
+ * Initialization, broadcast and reset recovery first wait for the queue to become empty and then use the blocking functions.
+ * Requires I2C_HARDWARE 1 of SoftI2CMasterConfig.h. Bit banging one half bit per timer interrupt would require
+ * an interrupt every 1.25 us at 400 kHz, which is not possible with a 16 MHz AVR.
+ * The TWI interrupt vector is used, so the Arduino Wire library cannot be used in the same program.
+ * I2C_TRANSFER_QUEUE_SIZE bytes RAM. Each transmission requires its data bytes + 3 bytes for address, length and register.
+ * A transmission, which does not fit into the queue in the servo interrupt, is dropped, since the queue cannot be sent there.
+ */
+//#define ENABLE_SOFT_I2C_INTERRUPT_TRANSFER
+#  if defined(ENABLE_SOFT_I2C_INTERRUPT_TRANSFER)
+#    if !defined(__AVR__) || !defined(USE_SOFT_I2C_MASTER)
+#undef ENABLE_SOFT_I2C_INTERRUPT_TRANSFER
+#    elif !defined(I2C_TRANSFER_QUEUE_SIZE)
+#define I2C_TRANSFER_QUEUE_SIZE 128 // Must be 128 or 256, to hold the largest frame buffer transmission of 67 bytes
+#    endif
+#  endif
+/*
+ * If ENABLE_PCA9685_SYNCHRONOUS_COMMIT is defined, flushPCA9685FrameBuffers() sends the transmissions for all boards without
+ * stop condition, i.e. each transmission is started with a repeated start. A PCA9685 takes its new register values
+ * only at a stop condition (OCH bit of MODE2 is 0), so all boards change their outputs at the single stop at the end of the frame.
+ * Without this, the boards sent first change up to one PWM period earlier than the last ones, which skews moves started
+ * by synchronizeAllServosAndStartInterrupt() of servos at different boards.
+ * For Wire, the final stop is sent by an empty transmission to the PCA9685_ALLCALL_ADDRESS, which costs one byte per bus and frame.
+ * Boards above MAX_PCA9685_EXPANDERS are not buffered and therefore not synchronized.
+ * Requires repeated start by endTransmission(false), the ESP32 Wire does not support it for write only transmissions,
+ * so the option is ignored there and for ENABLE_SOFT_I2C_INTERRUPT_TRANSFER.
+ * Implies ENABLE_PCA9685_FRAME_COMMIT.
+ */
+//#define ENABLE_PCA9685_SYNCHRONOUS_COMMIT
+#  if defined(ENABLE_PCA9685_SYNCHRONOUS_COMMIT)
+#    if defined(ESP32) || defined(ENABLE_SOFT_I2C_INTERRUPT_TRANSFER)
+#undef ENABLE_PCA9685_SYNCHRONOUS_COMMIT
+#    elif !defined(ENABLE_PCA9685_FRAME_COMMIT)
+#define ENABLE_PCA9685_FRAME_COMMIT
+#    endif
+#  endif
+/*
+ * Each PCA9685 board is initialized only at the first attach of one of its servos. Its I2C bus is initialized
+ * and all expanders on the bus are reset only at the first attach of a servo of a board on this bus.
+ * Boards above MAX_PCA9685_EXPANDERS are initialized at every attach and are not buffered for ENABLE_PCA9685_FRAME_COMMIT.
+ */
+#  if !defined(MAX_PCA9685_EXPANDERS)
+#define MAX_PCA9685_EXPANDERS ((MAX_EASING_SERVOS + 15) / 16) // Number of PCA9685 boards, which can be registered
+#  endif
+#  if defined(ENABLE_PCA9685_FRAME_COMMIT)
+/*
+ * The Arduino Wire library can send only BUFFER_LENGTH bytes with one transmission.
+ * We need 1 byte for the register address and 4 bytes for each channel.
+ */
+#    if !defined(PCA9685_MAX_CHANNELS_PER_TRANSMISSION)
+#      if defined(USE_SOFT_I2C_MASTER)
+#define PCA9685_MAX_CHANNELS_PER_TRANSMISSION   16 // SoftI2CMaster has no buffer and streams the bytes directly
+#      elif defined(I2C_BUFFER_LENGTH)
+#define PCA9685_MAX_CHANNELS_PER_TRANSMISSION   ((I2C_BUFFER_LENGTH - 1) / 4) // 31 for ESP32 with 128 byte buffer
+#      elif defined(BUFFER_LENGTH)
+#define PCA9685_MAX_CHANNELS_PER_TRANSMISSION   ((BUFFER_LENGTH - 1) / 4) // 7 for AVR with 32 byte buffer
+#      else
+#define PCA9685_MAX_CHANNELS_PER_TRANSMISSION   7 // Assume 32 byte buffer
+#      endif
+#    endif
+/*
+ * Costs of an additional transmission in bytes, used to decide if the unchanged channels between two runs of changed channels
+ * are sent again, to join the two runs to one transmission. Each unchanged channel costs 4 bytes.
+ * Address byte + register byte + start and stop condition + the software overhead of beginTransmission() / endTransmission().
+ * 4 joins runs separated by one unchanged channel, 0 disables joining.
+ */
+#    if !defined(PCA9685_TRANSMISSION_OVERHEAD_BYTES)
+#define PCA9685_TRANSMISSION_OVERHEAD_BYTES     4
+#    endif
+#  endif // defined(ENABLE_PCA9685_FRAME_COMMIT)
+/*
+ * If ENABLE_PCA9685_WRITE_BUDGET is defined, updateAllServos() sends at most sPCA9685WriteBudgetBytes I2C bytes for PCA9685 servos per frame.
+ * Servos with SERVO_WRITE_PRIORITY_HIGH and the end positions of all moves are always written.
+ * If the budget is exhausted, the intermediate positions of the SERVO_WRITE_PRIORITY_LOW servos are deferred to the next frame,
+ * where the low priority servos are served round robin, starting with the first servo deferred in the last frame.
+ * So an overload degrades to a lower update rate of the low priority servos instead of overrunning the refresh interval.
+ * getNumberOfDeferredPCA9685Writes() returns the number of deferred writes.
+ */
+//#define ENABLE_PCA9685_WRITE_BUDGET
+#  if defined(ENABLE_PCA9685_WRITE_BUDGET)
+#    if !defined(PCA9685_WRITE_BUDGET_BYTES)
+#define PCA9685_WRITE_BUDGET_BYTES  96 // 16 servos without ENABLE_PCA9685_FRAME_COMMIT, around 1 ms at 800 kHz and 9 ms at 100 kHz
+#    endif
+#    if defined(ENABLE_PCA9685_FRAME_COMMIT)
+#define PCA9685_BYTES_PER_SERVO_WRITE   4 // 4 data bytes in the auto increment transmission
+#    else
+#define PCA9685_BYTES_PER_SERVO_WRITE   6 // address + register + 4 data bytes
+#    endif
+#define SERVO_WRITE_PRIORITY_LOW    0
+#define SERVO_WRITE_PRIORITY_HIGH   1
+#  endif
 #endif // defined(USE_PCA9685_SERVO_EXPANDER)
+// Outside of the PCA9685 block, otherwise the FreeRTOS declarations of ServoEasing.hpp are compiled for other servo libraries
+#if defined(ENABLE_PCA9685_PARALLEL_BUSES) && (!defined(USE_PCA9685_SERVO_EXPANDER) || !defined(ESP32) || defined(USE_SOFT_I2C_MASTER))
+#undef ENABLE_PCA9685_PARALLEL_BUSES
+#endif
 
 
 /*****************************************************************************************
@@ -160,9 +425,71 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 #if !defined(INVALID_SERVO)
 #define INVALID_SERVO    255     // flag indicating an invalid servo index (from Servo.h)
 #endif
+/*
+ * Period of servo refresh and of the servo easing interrupt. Digital servos accept periods down to 3000 us (333 Hz).
+ * A shorter period reduces the control latency and gives smoother movements.
+ * The PCA9685 prescaler, the microseconds to PCA9685 unit conversion and the period of all easing timers are derived from this value.
+ * The Arduino Servo library always generates pulses with its own REFRESH_INTERVAL of 20 ms,
+ * so for a shorter period, you must use the PCA9685 expander, the lightweight, the sorted soft or the hardware servo library.
+ * Use multiples of 1000 us, since some platforms (e.g. ESP32 / ESP8266 Ticker) and delay() only support milliseconds.
+ */
+#if !defined(REFRESH_INTERVAL_MICROS)
 #define REFRESH_INTERVAL_MICROS REFRESH_INTERVAL         // 20000
-#define REFRESH_INTERVAL_MILLIS (REFRESH_INTERVAL/1000)  // 20 - used for delay()
-#define REFRESH_FREQUENCY (MILLIS_IN_ONE_SECOND/REFRESH_INTERVAL_MILLIS) // 50
+#endif
+#if REFRESH_INTERVAL_MICROS < 2500
+#error REFRESH_INTERVAL_MICROS must be at least 2500, since servo pulses can be up to 2500 us
+#endif
+#if REFRESH_INTERVAL_MICROS != REFRESH_INTERVAL && !defined(USE_PCA9685_SERVO_EXPANDER) && !defined(USE_LEIGHTWEIGHT_SERVO_LIB) \
+    && !defined(USE_SORTED_SOFT_SERVO_LIB) && !defined(USE_HARDWARE_SERVO_LIB) && !defined(ENABLE_SIMULATION_MODE)
+#warning Refresh period of Servo library (REFRESH_INTERVAL) cannot be changed, only the period of the easing interrupt is changed by REFRESH_INTERVAL_MICROS.
+#endif
+#define REFRESH_INTERVAL_MILLIS (REFRESH_INTERVAL_MICROS/1000)  // 20 - used for delay()
+#define REFRESH_FREQUENCY (1000000L/REFRESH_INTERVAL_MICROS) // 50
+
+/*
+ * If ENABLE_ESP32_SERVO_TASK is defined, the servos of an ESP32 are not updated by the Ticker, but by a FreeRTOS task
+ * pinned to core SERVO_EASING_TASK_CORE, which calls handleServoTimerInterrupt() with an exact period by vTaskDelayUntil().
+ * The task sleeps while no servo is moving and is woken up by enableServoEasingInterrupt().
+ * Moves can be sent to the task by sendEaseToCommand() and sendEaseToDCommand(), then they are started by the task itself,
+ * at the begin of the next frame, and the loop and the task never access the same servo at the same time.
+ * The I2C is not disturbed by the Ticker and runs with 400 kHz.
+ * Requires 4 kByte RAM for the task stack.
+ */
+//#define ENABLE_ESP32_SERVO_TASK
+#if defined(ENABLE_ESP32_SERVO_TASK)
+#  if !defined(ESP32)
+#undef ENABLE_ESP32_SERVO_TASK
+#  else
+#    if !defined(SERVO_EASING_TASK_CORE)
+#define SERVO_EASING_TASK_CORE              0 // loop() runs on core 1
+#    endif
+#    if !defined(SERVO_EASING_TASK_PRIORITY)
+#define SERVO_EASING_TASK_PRIORITY          10 // loop() has priority 1, WiFi and Bluetooth tasks have more than 17
+#    endif
+#    if !defined(SERVO_EASING_TASK_STACK_SIZE)
+#define SERVO_EASING_TASK_STACK_SIZE        4096 // bytes
+#    endif
+#  endif
+#endif
+/*
+ * If ENABLE_RP2040_CORE1_SERVO_ENGINE is defined, the servos of a RP2040 with the pico core are not updated by a repeating timer
+ * on the application core, but by an endless loop on core 1, which is launched by the first enableServoEasingInterrupt().
+ * All easing computations and I2C transfers are then done by core 1 with a constant frame period.
+ * Moves can be sent to core 1 by sendEaseToCommand() and sendEaseToDCommand(), which use a lock-free ring buffer.
+ * You cannot use setup1() and loop1() of the pico core together with this option.
+ */
+//#define ENABLE_RP2040_CORE1_SERVO_ENGINE
+#if defined(ENABLE_RP2040_CORE1_SERVO_ENGINE) && (!defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED))
+#undef ENABLE_RP2040_CORE1_SERVO_ENGINE
+#endif
+#if defined(ENABLE_ESP32_SERVO_TASK) || defined(ENABLE_RP2040_CORE1_SERVO_ENGINE)
+#  if !defined(SERVO_EASING_COMMAND_QUEUE_LENGTH)
+#define SERVO_EASING_COMMAND_QUEUE_LENGTH   MAX_EASING_SERVOS // maximum number of commands sent during one frame
+#  endif
+#  if SERVO_EASING_COMMAND_QUEUE_LENGTH > 254
+#error SERVO_EASING_COMMAND_QUEUE_LENGTH must be smaller than 255
+#  endif
+#endif
 
 /*
  * Define `DISABLE_COMPLEX_FUNCTIONS` if space (1850 bytes) matters.
@@ -204,12 +531,21 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 #define DEFAULT_MICROSECONDS_FOR_135_DEGREE (2400 - ((2400 - 544) / 4)) // 1936
 #define DEFAULT_MICROSECONDS_FOR_180_DEGREE  2400
 
+#if REFRESH_INTERVAL_MICROS == 20000
 // Approximately 2 units per degree
 #define DEFAULT_PCA9685_UNITS_FOR_0_DEGREE    111 // 111.411 = 544 us
 #define DEFAULT_PCA9685_UNITS_FOR_45_DEGREE  (111 + ((491 - 111) / 4)) // 206
 #define DEFAULT_PCA9685_UNITS_FOR_90_DEGREE  (111 + ((491 - 111) / 2)) // 301 = 1472 us
 #define DEFAULT_PCA9685_UNITS_FOR_135_DEGREE (491 - ((491 - 111) / 4)) // 369
 #define DEFAULT_PCA9685_UNITS_FOR_180_DEGREE  491 // 491.52 = 2400 us
+#else
+// Units for the actual PCA9685 period, e.g. approximately 9 units per degree for 5000 us
+#define DEFAULT_PCA9685_UNITS_FOR_0_DEGREE   ((int)((4096L * DEFAULT_MICROSECONDS_FOR_0_DEGREE) / PCA9685_PERIOD_MICROS))
+#define DEFAULT_PCA9685_UNITS_FOR_45_DEGREE  ((int)((4096L * DEFAULT_MICROSECONDS_FOR_45_DEGREE) / PCA9685_PERIOD_MICROS))
+#define DEFAULT_PCA9685_UNITS_FOR_90_DEGREE  ((int)((4096L * DEFAULT_MICROSECONDS_FOR_90_DEGREE) / PCA9685_PERIOD_MICROS))
+#define DEFAULT_PCA9685_UNITS_FOR_135_DEGREE ((int)((4096L * DEFAULT_MICROSECONDS_FOR_135_DEGREE) / PCA9685_PERIOD_MICROS))
+#define DEFAULT_PCA9685_UNITS_FOR_180_DEGREE ((int)((4096L * DEFAULT_MICROSECONDS_FOR_180_DEGREE) / PCA9685_PERIOD_MICROS))
+#endif
 
 /*
  * Definitions for continuous rotating servo - Values are taken from the Parallax Continuous Rotation Servo manual
@@ -253,21 +589,842 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 #endif
 
 /*
- * The different easing functions:
- *
- * In order to reuse the IN functions for OUT and IN_OUT functions, the following call and result conversions are used internally.
- * FactorOfMovementCompletion is multiplied with delta microseconds and added to StartPosition to get the current position.
- *
- * 1. Using IN function direct: Call with PercentageOfCompletion/100 | 0.0 to 1.0. FactorOfMovementCompletion is returnValue (from 0.0 to 1.0)
- * 2. Using IN function to generate OUT function: Call with (1 - PercentageOfCompletion/100) | 1.0 to 0.0. FactorOfMovementCompletion = (1 - returnValue)
- * 3. Using IN function to generate IN_OUT function:
- *      In the first half, call with (2 * PercentageOfCompletion/100) | 0.0 to 1.0. FactorOfMovementCompletion = (0.5 * returnValue)
- *      In the second half, call with (2 - (2 * PercentageOfCompletion/100)) | 1.0 to 0.0. FactorOfMovementCompletion = ( 1- (0.5 * returnValue))
- * 4. Using IN function to generate bouncing_OUT_IN / mirrored_OUT function, which return to start point (like the upper half of a sine):
- *      In the first half, call with (1 - (2 * PercentageOfCompletion/100)) | 1.0 to 0.0. FactorOfMovementCompletion = (1 - returnValue) -> call OUT 2 times faster.
- *      In the second half, call with ((2 * PercentageOfCompletion/100) - 1) | 0.0 to 1.0. FactorOfMovementCompletion = (1- returnValue) -> call OUT 2 times faster and backwards.
- *
+ * The different easing functions:
+ *
+ * In order to reuse the IN functions for OUT and IN_OUT functions, the following call and result conversions are used internally.
+ * FactorOfMovementCompletion is multiplied with delta microseconds and added to StartPosition to get the current position.
+ *
+ * 1. Using IN function direct: Call with PercentageOfCompletion/100 | 0.0 to 1.0. FactorOfMovementCompletion is returnValue (from 0.0 to 1.0)
+ * 2. Using IN function to generate OUT function: Call with (1 - PercentageOfCompletion/100) | 1.0 to 0.0. FactorOfMovementCompletion = (1 - returnValue)
+ * 3. Using IN function to generate IN_OUT function:
+ *      In the first half, call with (2 * PercentageOfCompletion/100) | 0.0 to 1.0. FactorOfMovementCompletion = (0.5 * returnValue)
+ *      In the second half, call with (2 - (2 * PercentageOfCompletion/100)) | 1.0 to 0.0. FactorOfMovementCompletion = ( 1- (0.5 * returnValue))
+ * 4. Using IN function to generate bouncing_OUT_IN / mirrored_OUT function, which return to start point (like the upper half of a sine):
+ *      In the first half, call with (1 - (2 * PercentageOfCompletion/100)) | 1.0 to 0.0. FactorOfMovementCompletion = (1 - returnValue) -> call OUT 2 times faster.
+ *      In the second half, call with ((2 * PercentageOfCompletion/100) - 1) | 0.0 to 1.0. FactorOfMovementCompletion = (1- returnValue) -> call OUT 2 times faster and backwards.
+ *
+ */
+
+/*
+ * If USE_FIXED_POINT_EASING is defined, the QUADRATIC, CUBIC and QUARTIC easings with all call styles are computed
+ * with 16 and 32 bit integer arithmetic instead of float in update().
+ * The factors of time and movement completion are then in Q15 format, i.e. 0x8000 is 1.0.
+ * On an AVR without FPU, this saves most of the computation time of update() for e.g. EASE_CUBIC_IN_OUT.
+ * The resulting position may differ by 1 microsecond or unit from the float computation.
+ * Moves longer than 131 seconds and all other easings are still computed with float.
+ */
+//#define USE_FIXED_POINT_EASING
+
+/*
+ * If ENABLE_EASE_TRAPEZOIDAL is defined, the easing type EASE_TRAPEZOIDAL is available.
+ * It moves with constant acceleration up to the speed, then with constant speed and then with constant deceleration,
+ * i.e. with a trapezoidal velocity profile. The acceleration limit is set by setMaxAcceleration() in degrees per second squared.
+ * startEaseTo() then takes the speed as velocity limit and computes the minimum duration of the move under both limits.
+ * For startEaseToD(), the constant speed phase is reduced until the move fits into the given duration.
+ * If the duration is too short for the acceleration limit, the profile is triangular.
+ * A duration extended by synchronizeAllServosAndStartInterrupt() stretches the profile in time,
+ * so all synchronized servos stay within their own limits and reach their targets together.
+ * The profile is computed only with integer arithmetic. There are no OUT, IN_OUT and BOUNCING variants, since it is symmetric.
+ * It is not enabled by default, since it requires 4 bytes additional RAM per servo.
+ */
+//#define ENABLE_EASE_TRAPEZOIDAL
+
+/*
+ * If ENABLE_EASE_S_CURVE is defined, the easing type EASE_S_CURVE is available. It implies ENABLE_EASE_TRAPEZOIDAL.
+ * It is the jerk limited version of EASE_TRAPEZOIDAL, i.e. the acceleration is not switched, but ramped up and down
+ * with the jerk set by setMaxJerk() in degrees per second cubed. This results in the 7 segments
+ * jerk up, constant acceleration, jerk down, constant speed, jerk down, constant deceleration, jerk up.
+ * The segment boundaries are computed once with float at start of the move, the per frame evaluation
+ * is only a segment lookup and a polynomial of degree 3 in integer arithmetic.
+ * If the duration is too short for the limits, first the constant speed and then the constant acceleration segments are dropped.
+ * It is not enabled by default, since it requires 16 bytes additional RAM per servo.
+ */
+//#define ENABLE_EASE_S_CURVE
+#if defined(ENABLE_EASE_S_CURVE) && !defined(ENABLE_EASE_TRAPEZOIDAL)
+#define ENABLE_EASE_TRAPEZOIDAL
+#endif
+#if defined(ENABLE_EASE_TRAPEZOIDAL) && defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+#undef ENABLE_EASE_TRAPEZOIDAL
+#undef ENABLE_EASE_S_CURVE
+#endif
+#if defined(ENABLE_EASE_TRAPEZOIDAL) && !defined(DEFAULT_MAX_ACCELERATION)
+#define DEFAULT_MAX_ACCELERATION        360 // degrees per second squared, i.e. 90 degrees per second is reached after 250 ms
+#endif
+#if defined(ENABLE_EASE_S_CURVE) && !defined(DEFAULT_MAX_JERK)
+#define DEFAULT_MAX_JERK                1440 // degrees per second cubed, i.e. DEFAULT_MAX_ACCELERATION is reached after 250 ms
+#endif
+
+/*
+ * If ENABLE_EASE_TABLE is defined, the easing types EASE_TABLE_IN, _OUT, _IN_OUT and _BOUNCING are available.
+ * The IN curve is a piecewise linear table of int16_t breakpoint pairs in PROGMEM, registered by registerEaseTable().
+ * Each pair is the time in per mille of the move followed by the position in per mille of the movement.
+ * The table must start with time 0 and end with time 1000, positions below 0 or above 1000 give an overshoot.
+ * E.g. const int16_t OvershootCurve[] PROGMEM = { 0, 0, 600, 1100, 800, 950, 1000, 1000 };
+ * The curve is evaluated with integer arithmetic. The index of the current segment is cached
+ * and only moved forward or backward to the next segment, so the evaluation costs almost the same as a linear move.
+ */
+//#define ENABLE_EASE_TABLE
+#if defined(ENABLE_EASE_TABLE) && defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+#undef ENABLE_EASE_TABLE
+#endif
+#if defined(ENABLE_EASE_TABLE)
+#define EASE_TABLE_END_TIME             1000 // time of the last breakpoint
+#endif
+
+/*
+ * If ENABLE_FORWARD_DIFFERENCING is defined, the QUADRATIC, CUBIC and QUARTIC easings are not evaluated completely at each update(),
+ * if update() is called at regular intervals of REFRESH_INTERVAL_MILLIS, which is the case for the interrupt driven updates.
+ * Then the position of the next frame is computed by adding the precomputed forward differences of the easing polynomial,
+ * i.e. only with 2 to 4 64 bit integer additions (on AVR 2 to 4 times 8 byte additions).
+ * The forward differences are computed exactly at start of move, at the half of IN_OUT and BOUNCING moves,
+ * every FORWARD_DIFFERENCING_RESYNC_FRAMES frames and if the time between two updates is not REFRESH_INTERVAL_MILLIS +/- 1 ms (e.g. by polling).
+ * Requires 46 bytes additional RAM per servo.
+ */
+//#define ENABLE_FORWARD_DIFFERENCING
+#if defined(ENABLE_FORWARD_DIFFERENCING) && defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+#undef ENABLE_FORWARD_DIFFERENCING // Linear movement is already computed without float
+#endif
+#if defined(ENABLE_FORWARD_DIFFERENCING)
+#  if !defined(FORWARD_DIFFERENCING_RESYNC_FRAMES)
+#define FORWARD_DIFFERENCING_RESYNC_FRAMES  128 // 2.56 seconds, keeps the deviation of the QUARTIC easing below 1 unit
+#  endif
+#define FORWARD_DIFFERENCING_MAX_DEGREE     4
+#endif
+
+/*
+ * If ENABLE_TRAJECTORY_BUFFER is defined, the positions of non linear moves are not computed by the servo interrupt,
+ * but sampled in advance for each refresh interval by fillTrajectoryBuffers() into a ring buffer of TRAJECTORY_BUFFER_SIZE frame positions per servo.
+ * Then update() only interpolates between 2 buffered positions, so the time spent in the interrupt is constant and small
+ * for all easing types, even for user functions computing the inverse kinematics of a robot arm.
+ * Long moves are sampled in chunks, so fillTrajectoryBuffers() must be called from loop() at least every (TRAJECTORY_BUFFER_SIZE - 2) refresh intervals.
+ * This is done automatically by the blocking and the waiting functions of this library.
+ * For ENABLE_ESP32_SERVO_TASK and ENABLE_RP2040_CORE1_SERVO_ENGINE the buffers are filled by the servo task after each frame,
+ * and fillTrajectoryBuffers() must NOT be called by loop().
+ * If a frame position is not yet sampled, e.g. at the start of a move, update() computes it as before.
+ * Requires 2 * TRAJECTORY_BUFFER_SIZE + 6 bytes additional RAM per servo.
+ * Not available with ENABLE_FORWARD_DIFFERENCING, which requires update() to compute each frame.
+ */
+//#define ENABLE_TRAJECTORY_BUFFER
+#if defined(ENABLE_TRAJECTORY_BUFFER) && defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+#undef ENABLE_TRAJECTORY_BUFFER // Linear movement is computed faster than interpolated
+#endif
+#if defined(ENABLE_TRAJECTORY_BUFFER)
+#undef ENABLE_FORWARD_DIFFERENCING
+#  if !defined(TRAJECTORY_BUFFER_SIZE)
+#    if defined(__AVR__)
+#define TRAJECTORY_BUFFER_SIZE  8 // 160 ms for 20 ms refresh interval
+#    else
+#define TRAJECTORY_BUFFER_SIZE  32
+#    endif
+#  endif
+#  if ((TRAJECTORY_BUFFER_SIZE & (TRAJECTORY_BUFFER_SIZE - 1)) != 0) || (TRAJECTORY_BUFFER_SIZE < 4) || (TRAJECTORY_BUFFER_SIZE > 128)
+#error TRAJECTORY_BUFFER_SIZE must be a power of 2 between 4 and 128
+#  endif
+#endif
+
+/*
+ * If USE_EASING_LOOKUP_TABLES is defined, the SINE, CIRCULAR, BACK and ELASTIC easings do not call sin(), sqrt() and pow(),
+ * but interpolate linear between the values of a 65 entry table in program memory.
+ * This costs 130 bytes program memory per table, but saves the float library functions and most of the computation time.
+ * The ELASTIC table has 129 entries (258 bytes), since its oscillation grows towards the end.
+ * The CIRCULAR easing still calls sqrt() for the last 1/16 of the move, where the circle is too steep for a table.
+ * Maximum deviation for a move of 180 degree from 544 to 2400 us: SINE 0.2 us, BACK 0.8 us, CIRCULAR 1.1 us and ELASTIC 4.8 us,
+ * i.e. ELASTIC below 0.5 degree and all others below 1/8 degree. The IN_OUT call style has half of these values.
+ * BOUNCE is not changed, since it is already computed by simple polynomials.
+ */
+//#define USE_EASING_LOOKUP_TABLES
+#if defined(USE_EASING_LOOKUP_TABLES)
+#define EASING_LOOKUP_TABLE_INTERVALS   64
+#define ELASTIC_LOOKUP_TABLE_INTERVALS  128
+#define CIRCULAR_LOOKUP_TABLE_END       (60.0 / 64) // sqrt() is used above
+#define EASING_LOOKUP_TABLE_ONE         16384 // 1.0 in table
+#endif
+
+/*
+ * If USE_PRECOMPUTED_SCALE_FACTORS is defined, attach() computes the scale factors between degree and microseconds or units
+ * of each servo, so MicrosecondsOrUnitsToDegree(), MicrosecondsToDegree() and DegreeOrMicrosecondToMicrosecondsOrUnits()
+ * require only a multiplication and a shift instead of a 32 bit division.
+ * This speeds up startEaseTo(), retarget() and user easings returning degree, which are evaluated at each frame.
+ * Degree to microseconds or units gives the same result as before for 0 to 180 degree,
+ * microseconds or units to degree is exactly rounded instead of using a fixed rounding offset for the default servo range.
+ * Requires 8 bytes additional RAM per servo.
+ */
+//#define USE_PRECOMPUTED_SCALE_FACTORS
+
+/*
+ * If USE_FIXED_POINT_MOVE_SETUP is defined, the int and float versions of startEaseTo() and startEaseToD()
+ * only convert the target to microseconds or units and then share one integer move setup function.
+ * Float degree values are converted to 1/16 degree, which requires only one float multiplication.
+ * The duration for a speed is computed with 1/16 degree resolution from the microseconds or units to move,
+ * instead of from the difference of the rounded target and current degree values.
+ * With USE_PRECOMPUTED_SCALE_FACTORS, this requires only one 32 bit division.
+ * This saves program memory and makes the setup of many moves in one frame faster.
+ */
+//#define USE_FIXED_POINT_MOVE_SETUP
+
+/*
+ * If ENABLE_BATCHED_MOVE_SETUP is defined, setEaseToArrayPositionsSynchronizeAndStartInterrupt()
+ * and ServoEasingGroup::setEaseToPositionsSynchronizeAndStartInterrupt() set up a synchronized move of all servos
+ * from one target array. The first loop only converts the targets and computes the maximum duration.
+ * The second loop sets up all moves with this duration and one start time with interrupts disabled,
+ * so the servo interrupt never sees a partially set up pose and no move has to be rewritten afterwards.
+ * Implies USE_FIXED_POINT_MOVE_SETUP.
+ */
+//#define ENABLE_BATCHED_MOVE_SETUP
+#if defined(ENABLE_BATCHED_MOVE_SETUP) && !defined(USE_FIXED_POINT_MOVE_SETUP)
+#define USE_FIXED_POINT_MOVE_SETUP
+#endif
+
+/*
+ * If ENABLE_EXTERNAL_FRAME_BUFFER is defined, an application computing its own poses, e.g. by inverse kinematics
+ * or from a PC stream, can write them directly to a frame buffer instead of calling write() for each servo.
+ * getExternalFrameBuffer() returns the buffer, which contains one microseconds or units value per servo index.
+ * A value of EXTERNAL_FRAME_BUFFER_UNCHANGED (0) keeps the servo at its position.
+ * commitExternalFrameBuffer() hands the buffer over to the library and clears the other buffer for the next frame.
+ * The committed values are written with constraints, trim and reverse by the next updateAllServos(), together with all moves
+ * of this frame and with one I2C flush for ENABLE_PCA9685_FRAME_COMMIT. If the servo interrupt is not active, they are written at once.
+ * Only unchanged values are skipped and servos moved by startEaseTo() etc. are not changed.
+ * Requires 4 bytes RAM per servo.
+ */
+//#define ENABLE_EXTERNAL_FRAME_BUFFER
+#if defined(ENABLE_EXTERNAL_FRAME_BUFFER)
+#define EXTERNAL_FRAME_BUFFER_UNCHANGED 0 // Not a valid microseconds or units value
+#endif
+
+/*
+ * If ENABLE_EASING_TEMPLATES is defined, the easing type of a servo can be fixed at compile time
+ * by setEasingType<EASE_CUBIC_IN_OUT>() or by declaring it as ServoEasingT<EASE_CUBIC_IN_OUT>.
+ * An unsupported easing type, e.g. EASE_PRECISION_IN or a disabled one, then gives a compile error.
+ * The compiler generates a function for exactly this easing type and call style with the easing function inlined,
+ * and update() calls it by a function pointer stored in the servo instead of running the easing and call style switches.
+ * But only the selection is done at compile time. The call is still indirect, and the runtime switches are still compiled in
+ * for the servos using setEasingType(aEasingType), so program memory is not reduced and the pointer requires 2 bytes RAM per servo on AVR.
+ * Not available for the USER and PRECISION easings, which require the servo object.
+ * To drop the code of unused easings completely, additionally define only the required ENABLE_EASE_* macros.
+ */
+//#define ENABLE_EASING_TEMPLATES
+
+/*
+ * If ENABLE_PACKED_UPDATE_KERNEL is defined, the values required to compute linear movements are additionally
+ * stored in static arrays indexed by servo index, i.e. start, delta, duration, start time and current position.
+ * Then updateAllServos() computes all moving linear servos in one loop over these arrays with a single millis() call,
+ * and accesses the ServoEasing object only if a new value must be written or the move ends.
+ * Non linear and paused servos are updated as before by calling update().
+ * Requires 13 bytes additional RAM per servo.
+ * Not available with PRINT_FOR_SERIAL_PLOTTER, which requires write at every update.
+ */
+//#define ENABLE_PACKED_UPDATE_KERNEL
+
+/*
+ * If ENABLE_SIMD_PACKED_UPDATE_KERNEL is defined, the packed update kernel first computes the fraction of completion
+ * of each servo as Q15 value, with only one division for all servos with the same start time and duration, e.g. a synchronized group.
+ * Then all new positions are computed in one loop as start + ((delta * fraction) >> 15), which does not access the ServoEasing objects.
+ * On CPUs with the ARM DSP extension (Cortex-M4, M7 and M33), two servos are computed at once by the packed 16 bit
+ * instructions SMULBB, SMULTT, PKHBT and SADD16. All other CPUs, e.g. RP2040 and ESP32, use a scalar loop with bit identical results.
+ * Requires 4 bytes additional RAM per servo. Implies ENABLE_PACKED_UPDATE_KERNEL.
+ */
+//#define ENABLE_SIMD_PACKED_UPDATE_KERNEL
+#if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL) && !defined(ENABLE_PACKED_UPDATE_KERNEL)
+#define ENABLE_PACKED_UPDATE_KERNEL
+#endif
+#if defined(ENABLE_PACKED_UPDATE_KERNEL) && defined(PRINT_FOR_SERIAL_PLOTTER)
+#undef ENABLE_PACKED_UPDATE_KERNEL
+#endif
+#if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL) && !defined(ENABLE_PACKED_UPDATE_KERNEL)
+#undef ENABLE_SIMD_PACKED_UPDATE_KERNEL // ENABLE_PACKED_UPDATE_KERNEL was disabled above
+#endif
+#if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL)
+#define PACKED_KERNEL_ARRAY_SIZE    ((MAX_EASING_SERVOS + 1) & ~1) // even number of entries for the loop over pairs of servos
+#define PACKED_KERNEL_ALIGNMENT     __attribute__((aligned(4)))    // pairs of servos are read as one 32 bit value
+#define PACKED_FRACTION_INVALID     (-1) // Q15 fractions of time completion are never negative
+#else
+#define PACKED_KERNEL_ARRAY_SIZE    MAX_EASING_SERVOS
+#define PACKED_KERNEL_ALIGNMENT
+#endif
+
+/*
+ * If ENABLE_MICROS_TIME_BASE is defined, all internal time values of a move are in microseconds instead of milliseconds.
+ * The start time is taken from micros() and the duration is stored as 32 bit value.
+ * This avoids the 1 ms quantization of the fraction of completion for short and fast moves, e.g. at higher refresh rates.
+ * The API still uses milliseconds for durations, only mMillisAtStartMove and mMillisForCompleteMove contain microseconds.
+ * All time differences are computed unsigned, so the overflow of micros() after 71 minutes does not matter.
+ * Linear moves are then computed with float, to avoid the overflow of 32 bit integer multiplication.
+ * Not available with ENABLE_PACKED_UPDATE_KERNEL, which uses 16 bit durations.
+ */
+//#define ENABLE_MICROS_TIME_BASE
+
+/*
+ * If ENABLE_FRAME_COUNTER_TIME_BASE is defined, the time is not read from millis() or micros(),
+ * but each call of updateAllServos() advances the time by one refresh interval.
+ * This gives a jitter free time base and saves the millis() call, but is only correct
+ * if updateAllServos() is called exactly once per refresh interval, e.g. by the servo timer interrupt.
+ * Moves started between two frames start at the time of the previous frame.
+ * ServoEasing::update() does not advance the time, so the blocking functions use updateAllServos() then.
+ */
+//#define ENABLE_FRAME_COUNTER_TIME_BASE
+
+/*
+ * If ENABLE_TIME_SCALE is defined, all moves use a global motion time, which is advanced by updateAllServos()
+ * by the real time since the last frame multiplied with the factor set by setTimeScalePercent().
+ * So a whole show can be played in slow motion with e.g. 50 or faster with e.g. 200 percent without changing any move.
+ * A late frame, i.e. more than 1.5 refresh intervals after the last one, advances the motion time by at most 1.5 refresh intervals.
+ * So under overload all moves are slowed down together instead of jumping to later positions.
+ * The number of late frames is returned by getNumberOfLateFrames().
+ * Like for ENABLE_FRAME_COUNTER_TIME_BASE, moves started between two frames start at the time of the previous frame
+ * and the blocking functions use updateAllServos() to advance the time.
+ * With ENABLE_FRAME_COUNTER_TIME_BASE, each frame advances the motion time by the scaled refresh interval.
+ */
+//#define ENABLE_TIME_SCALE
+/*
+ * If ENABLE_FRAME_WATCHDOG is defined, updateAllServos() measures the real time since the last frame.
+ * If FRAME_WATCHDOG_MAX_CONSECUTIVE_LATE_FRAMES frames in a row are more than 1.5 refresh intervals late,
+ * e.g. because the interrupt is blocked by I2C or a long callback, all servos are stopped by stopAllServos().
+ * The first frame after an idle period is always late, so do not set the limit below 2.
+ * The number of stops is returned by getNumberOfFrameWatchdogStops().
+ */
+//#define ENABLE_FRAME_WATCHDOG
+#if defined(ENABLE_FRAME_WATCHDOG) && !defined(FRAME_WATCHDOG_MAX_CONSECUTIVE_LATE_FRAMES)
+#define FRAME_WATCHDOG_MAX_CONSECUTIVE_LATE_FRAMES  5
+#endif
+#if defined(ENABLE_TIME_SCALE) && !defined(DEFAULT_TIME_SCALE_PERCENT)
+#define DEFAULT_TIME_SCALE_PERCENT                  100
+#endif
+
+#if defined(ENABLE_MICROS_TIME_BASE)
+#undef ENABLE_PACKED_UPDATE_KERNEL
+#undef ENABLE_SIMD_PACKED_UPDATE_KERNEL
+#define SERVO_EASING_TIME_UNITS_PER_MILLISECOND 1000L
+#define SERVO_EASING_TIME_UNITS_PER_REFRESH     REFRESH_INTERVAL_MICROS
+#define getServoEasingRealTime()                micros()
+#else
+#define SERVO_EASING_TIME_UNITS_PER_MILLISECOND 1
+#define SERVO_EASING_TIME_UNITS_PER_REFRESH     REFRESH_INTERVAL_MILLIS
+#define getServoEasingRealTime()                millis()
+#endif
+#if defined(ENABLE_FRAME_COUNTER_TIME_BASE) || defined(ENABLE_TIME_SCALE)
+#define getServoEasingTime()                    getServoEasingFrameTime()
+#else
+#define getServoEasingTime()                    getServoEasingRealTime()
+#endif
+
+/*
+ * If ENABLE_COMPACT_SERVO_LAYOUT is defined, the RAM used for each servo is reduced by:
+ * - Storing start and stop time of a move as 16 bit values. Time differences are computed with the lower 16 bit of getServoEasingTime().
+ *   Moves and pauses can then last up to 65 seconds and update() must be called at least every 65 seconds while a servo moves.
+ * - Storing the flags for reverse, pause and expander as bits of one byte. The pause flag is not packed for ENABLE_STALL_DETECTION.
+ *   These flags must only be changed by loop() and not by an interrupt, because changing one bit writes the whole byte.
+ * - Storing ServoEasingNextPositionArray[] as int16_t instead of float, i.e. without fractions of degrees.
+ * Saves 7 bytes RAM per servo on AVR, 8 bytes per servo for PCA9685 with USE_SERVO_LIB.
+ * To save 2 further bytes define DISABLE_TARGET_POSITION_REACHED_HANDLER, and do not define ENABLE_EASE_USER, which requires 4 bytes.
+ * Not available with ENABLE_MICROS_TIME_BASE, which requires 32 bit time values.
+ */
+//#define ENABLE_COMPACT_SERVO_LAYOUT
+#if defined(ENABLE_COMPACT_SERVO_LAYOUT) && defined(ENABLE_MICROS_TIME_BASE)
+#undef ENABLE_COMPACT_SERVO_LAYOUT
+#endif
+#if defined(ENABLE_COMPACT_SERVO_LAYOUT)
+typedef uint16_t ServoEasingTimeType;
+typedef int16_t ServoEasingPositionType;
+#define COMPACT_TIME_NEGATIVE_THRESHOLD     0xFF00 // Differences above are taken as negative, i.e. move was started up to 256 ms after the time was taken
+#else
+typedef uint32_t ServoEasingTimeType;
+typedef float ServoEasingPositionType;
+#endif
+#if defined(ENABLE_MICROS_TIME_BASE)
+typedef uint32_t ServoEasingDurationType; // Type of mMillisForCompleteMove, in microseconds
+#else
+typedef uint_fast16_t ServoEasingDurationType;
+#endif
+
+/*
+ * Disables the TargetPositionReachedHandler and setTargetPositionReachedHandler(). Saves 2 bytes RAM per servo on AVR.
+ */
+//#define DISABLE_TARGET_POSITION_REACHED_HANDLER
+
+/*
+ * If ENABLE_ACTIVE_SERVO_LIST is defined, all moving servos are additionally stored in the compact list sActiveServos[].
+ * A servo is added by startEaseTo*() and removed at end of move, by stop() and by detach().
+ * Then updateAllServos() and isOneServoMoving() only process the moving servos instead of all attached servos.
+ * This reduces the time for each update if only a few of many servos are moving.
+ * Requires 3 bytes additional RAM per servo on AVR.
+ * Not available with PRINT_FOR_SERIAL_PLOTTER, which requires update of all servos.
+ */
+//#define ENABLE_ACTIVE_SERVO_LIST
+#if defined(ENABLE_ACTIVE_SERVO_LIST) && defined(PRINT_FOR_SERIAL_PLOTTER)
+#undef ENABLE_ACTIVE_SERVO_LIST
+#endif
+
+/*
+ * If ENABLE_DENSE_SERVO_REGISTRY is defined, all attached servos are additionally stored without holes in sAttachedServos[].
+ * A servo is added by attach() and removed by detach(), which moves the last entry to the position of the detached servo.
+ * Then updateAllServos(), isOneServoMoving(), stopAllServos(), writeAllServos(), setSpeedForAllServos(), pauseAllServos()
+ * and resumeWith*InterruptsAllServos() process only the attached servos without NULL checks.
+ * The servo index and ServoEasingArray[] are not changed, so ServoEasingNextPositionArray[] and all index based functions work as before.
+ * The size of both arrays is MAX_EASING_SERVOS, which you can define before the include of ServoEasing.hpp.
+ * Requires 3 bytes additional RAM per servo on AVR.
+ */
+//#define ENABLE_DENSE_SERVO_REGISTRY
+
+/*
+ * If ENABLE_UPDATE_PRIORITY_ORDER is defined, updateAllServos() updates the servos in the order of their update priority
+ * set by setUpdatePriority() instead of the order of their index. Servos with a higher value are updated and written first,
+ * servos with the same priority in the order of their index. The default priority is 0.
+ * flushPCA9685FrameBuffers() sends the PCA9685 boards in the order of the servo with the highest priority on each board.
+ * So critical joints like grippers or balance legs get the lowest latency even with slow I2C.
+ * The order is computed by attach(), detach() and setUpdatePriority() and stored in one of two buffers,
+ * which are swapped after computation, so the interrupt never sees a partially sorted list.
+ * updateAllServos() then does not use the lists of ENABLE_ACTIVE_SERVO_LIST and ENABLE_DENSE_SERVO_REGISTRY.
+ * The linear servos of ENABLE_PACKED_UPDATE_KERNEL are still updated before the other ones, each group in priority order.
+ * Requires 3 bytes additional RAM per servo on AVR.
+ */
+//#define ENABLE_UPDATE_PRIORITY_ORDER
+
+/*
+ * If ENABLE_MOTION_QUEUE is defined, each servo has a ring buffer of MOTION_QUEUE_SIZE - 1 moves,
+ * which can be filled by queueEaseTo() and queueEaseToD().
+ * At the end of the current move, update() starts the next queued move immediately in the same frame,
+ * using the end time of the last move as start time. So there is no gap and no lost time between consecutive moves.
+ * The TargetPositionReachedHandler is only called, if the last move of the queue ended.
+ * Requires (6 * MOTION_QUEUE_SIZE) + 2 bytes additional RAM per servo.
+ */
+//#define ENABLE_MOTION_QUEUE
+#if defined(ENABLE_MOTION_QUEUE)
+#  if !defined(MOTION_QUEUE_SIZE)
+#define MOTION_QUEUE_SIZE   4 // Must be a power of 2. One entry is always unused, to distinguish between full and empty.
+#  endif
+#  if (MOTION_QUEUE_SIZE & (MOTION_QUEUE_SIZE - 1)) != 0 || MOTION_QUEUE_SIZE > 128
+#error MOTION_QUEUE_SIZE must be a power of 2 and not greater than 128
+#  endif
+#endif
+
+/*
+ * If ENABLE_SERVO_MAILBOX is defined, each servo has a mailbox for one move, which is written by postEaseTo() or postEaseToD()
+ * and applied by updateAllServos() at the begin of the next frame, i.e. by the servo timer interrupt.
+ * Thus a running move can be retargeted from loop() without any blocking, without noInterrupts()
+ * and without the risk, that the interrupt reads a half written start position, time or delta.
+ * A mailbox holds only the latest move, a move posted before the previous one was applied replaces it.
+ * The mailbox is protected by a sequence counter, which is odd while the mailbox is written, so it works also across cores.
+ * Requires 8 bytes additional RAM per servo.
+ */
+//#define ENABLE_SERVO_MAILBOX
+
+/*
+ * If ENABLE_RETARGET is defined, retarget() changes the target of a running move without stopping the servo.
+ * startEaseTo() on a moving servo starts the new move from the current position with zero speed, which results in a stutter,
+ * if the target is changed at each frame e.g. by a joystick or a sensor.
+ * retarget() starts a cubic Hermite segment from the current position and speed of the running move to the new target,
+ * which ends with zero speed. So the target can be changed at each frame and the next update() already moves to the new target.
+ * The duration of the segment is computed from the speed parameter like for startEaseTo(), but it is shortened,
+ * if the segment would otherwise overshoot the target because of a slower new speed.
+ * If the new target is behind the servo, the servo first brakes with at most RETARGET_MAX_DECELERATION
+ * and then moves to the new target like with startEaseTo().
+ * The positions of the segment are limited to the 0 to 180 degree range and the min and max constraints of the servo.
+ * The segment is used instead of the easing type, for a servo at rest retarget() is the same as startEaseTo().
+ * Requires 6 bytes additional RAM per servo.
+ */
+//#define ENABLE_RETARGET
+#if defined(ENABLE_RETARGET) && defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+#undef ENABLE_RETARGET
+#endif
+#if !defined(RETARGET_MAX_DECELERATION)
+#define RETARGET_MAX_DECELERATION   720 // Degree per second squared. Brakes from 180 degree per second within 30 degree and 1/2 second.
+#endif
+
+/*
+ * If ENABLE_SPLINE_PATH is defined, startSplinePath() moves the servo through an array of waypoints without stopping at them.
+ * The path is a Catmull-Rom spline, i.e. a chain of cubic Hermite segments with the tangent (next - previous) / 2 at each waypoint.
+ * It starts at the current position and ends at the last waypoint, both with zero speed.
+ * The polynomial coefficients of a segment are computed once at its start, the per frame evaluation is a polynomial of degree 3
+ * in integer arithmetic. The next segment is started by update() in the same frame at the exact end time of the current segment.
+ * All servos of a group started with the same number of waypoints and the same segment duration,
+ * e.g. by setSplinePath() and synchronizeAllServosAndStartInterrupt(), stay synchronized at each waypoint.
+ * The waypoint array is not copied and must be valid until the end of the path.
+ * Requires 14 bytes additional RAM per servo on AVR.
+ */
+//#define ENABLE_SPLINE_PATH
+#if defined(ENABLE_SPLINE_PATH) && defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+#undef ENABLE_SPLINE_PATH
+#endif
+
+#if defined(USE_FIXED_POINT_EASING) || defined(ENABLE_EASE_TRAPEZOIDAL) || defined(ENABLE_RETARGET) || defined(ENABLE_SPLINE_PATH) \
+        || defined(ENABLE_EASE_TABLE)
+#define FIXED_POINT_ONE                 0x8000 // 1.0 in Q15 format
+#define FIXED_POINT_HALF                0x4000 // 0.5 in Q15 format
+#endif
+
+/*
+ * If ENABLE_TIMELINE_PLAYER is defined, startTimeline() plays a table of keyframes stored in PROGMEM.
+ * The keyframes are started by updateAllServos() and therefore also by the servo timer interrupt, so the main loop is free.
+ * Each keyframe is a TIMELINE_KEYFRAME() followed by one target value for each bit set in the servo mask.
+ * Bit 0 of the servo mask is the first attached servo, i.e. the servo with mServoIndex 0. The table must end with TIMELINE_END.
+ * The move of each keyframe starts exactly at the specified time, even if updateAllServos() is called later.
+ * Example:
+ * const uint16_t WaveTimeline[] PROGMEM = {
+ *   TIMELINE_KEYFRAME(0, 500, 0x03, EASE_CUBIC_IN_OUT), 90, 120, // Move servo 0 to 90 and servo 1 to 120 degree in 500 ms
+ *   TIMELINE_KEYFRAME(500, 300, 0x02, EASE_LINEAR), 60,          // 500 ms later, move servo 1 to 60 degree in 300 ms
+ *   TIMELINE_END };
+ */
+//#define ENABLE_TIMELINE_PLAYER
+#if defined(ENABLE_TIMELINE_PLAYER)
+#define TIMELINE_KEYFRAME(aMillisAfterPreviousKeyframe, aMillisForMove, aServoMask, aEasingType) \
+    (aMillisAfterPreviousKeyframe), (aMillisForMove), (aServoMask), (aEasingType)
+#define TIMELINE_END    0xFFFF // Is stored at the position of aMillisAfterPreviousKeyframe of the next keyframe
+#define TIMELINE_MAX_SERVOS 16 // Number of bits in servo mask
+#endif
+
+/*
+ * If ENABLE_POSITION_FRAME_RECEIVER is defined, target positions for many servos can be streamed in a compact binary frame.
+ * Call receivePositionFrames(&Serial) in loop(), or receivePositionFrameByte() for each received byte, e.g. from a receive interrupt or DMA buffer.
+ * A valid frame is copied to ServoEasingNextPositionArray[] and started by startReceivedPositionFrame().
+ * The moves of the servos of the frame are synchronized with each other, the moves of all other servos are not changed.
+ * Frame format, all values little endian:
+ *   POSITION_FRAME_SYNC_BYTE
+ *   flags                  POSITION_FRAME_FLAG_DURATION -> duration is contained
+ *   servo mask (32 bit)    Bit 0 is the first attached servo, i.e. the servo with mServoIndex 0. Bits >= MAX_EASING_SERVOS are invalid.
+ *   duration (16 bit)      Milliseconds for the move. If not contained, the speed set by setSpeed() is taken.
+ *   target (16 bit signed) One degree or microsecond value (as for startEaseTo()) for each bit set in the servo mask
+ *   CRC-8 (polynomial 0x07, start value 0) of all bytes after the sync byte
+ * Each byte after the sync byte, which is equal to POSITION_FRAME_SYNC_BYTE or POSITION_FRAME_ESCAPE_BYTE,
+ * is sent as POSITION_FRAME_ESCAPE_BYTE followed by the byte XOR POSITION_FRAME_ESCAPE_XOR.
+ * So a sync byte always starts a new frame and the receiver resynchronizes immediately after a lost byte.
+ * A frame with 16 servos and duration has 41 bytes (without escapes), so 28 frames per second can be received at 115200 baud.
+ * Frames with a wrong CRC and frames received before the previous frame was started are discarded and counted.
+ */
+//#define ENABLE_POSITION_FRAME_RECEIVER
+#if defined(ENABLE_POSITION_FRAME_RECEIVER)
+#define POSITION_FRAME_SYNC_BYTE        0x5A
+#define POSITION_FRAME_ESCAPE_BYTE      0x5B
+#define POSITION_FRAME_ESCAPE_XOR       0x20
+#define POSITION_FRAME_FLAG_DURATION    0x01
+#endif
+
+/*
+ * If ENABLE_SERVO_EASING_TASKS is defined, movement sequences can be written as cooperative tasks instead of blocking code.
+ * A task function bool myTask(ServoEasingTask *aTask) is written linearly between SERVO_EASING_TASK_BEGIN() and SERVO_EASING_TASK_END(),
+ * but instead of waiting in a delay() loop, it returns at each SERVO_EASING_TASK_WAIT_*() and resumes at this point at the next call.
+ * runServoEasingTasks() must be called in loop(). It calls updateAllServos() every REFRESH_INTERVAL_MILLIS if interrupts are not active
+ * and then runs all started tasks. So several independent sequences and sensor reads can run concurrently.
+ * As for all protothreads, local variables are not preserved across waits, use static variables instead,
+ * and SERVO_EASING_TASK_WAIT_*() can not be used inside a switch statement.
+ * Example:
+ * bool waveTask(ServoEasingTask *aTask) {
+ *   SERVO_EASING_TASK_BEGIN(aTask);
+ *   Servo1.startEaseTo(120, 60, DO_NOT_START_UPDATE_BY_INTERRUPT);
+ *   SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, Servo1);
+ *   SERVO_EASING_TASK_DELAY(aTask, 500);
+ *   Servo1.startEaseTo(60, 60, DO_NOT_START_UPDATE_BY_INTERRUPT);
+ *   SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, Servo1);
+ *   SERVO_EASING_TASK_END(aTask);
+ * }
+ * ServoEasingTask WaveTask;
+ * startServoEasingTask(&WaveTask, &waveTask) in setup() and runServoEasingTasks() in loop().
+ */
+//#define ENABLE_SERVO_EASING_TASKS
+#if defined(ENABLE_SERVO_EASING_TASKS)
+struct ServoEasingTask {
+    bool (*TaskFunction)(struct ServoEasingTask *aTask); // Returns true if task has ended
+    uint16_t ResumeLine;            // Line of the last wait, 0 -> start of the task
+    uint32_t MillisAtStartOfWait;   // millis() at the start of the current wait
+    struct ServoEasingTask *NextTask;
+};
+#  if defined(__GNUC__) && (__GNUC__ >= 7)
+#define SERVO_EASING_TASK_FALLTHROUGH   __attribute__ ((fallthrough)) // suppress the -Wimplicit-fallthrough warning
+#  else
+#define SERVO_EASING_TASK_FALLTHROUGH
+#  endif
+#define SERVO_EASING_TASK_BEGIN(aTask)  switch ((aTask)->ResumeLine) { case 0:
+#define SERVO_EASING_TASK_WAIT_UNTIL(aTask, aCondition) \
+    do { (aTask)->ResumeLine = __LINE__; (aTask)->MillisAtStartOfWait = millis(); SERVO_EASING_TASK_FALLTHROUGH; case __LINE__: \
+         if (!(aCondition)) return false; } while (0)
+#define SERVO_EASING_TASK_YIELD(aTask)  do { (aTask)->ResumeLine = __LINE__; return false; case __LINE__:; } while (0)
+#define SERVO_EASING_TASK_DELAY(aTask, aMillisDelay) \
+    SERVO_EASING_TASK_WAIT_UNTIL(aTask, (millis() - (aTask)->MillisAtStartOfWait) >= (uint32_t) (aMillisDelay))
+#define SERVO_EASING_TASK_WAIT_FOR_SERVO(aTask, aServo)     SERVO_EASING_TASK_WAIT_UNTIL(aTask, !(aServo).isMoving())
+#define SERVO_EASING_TASK_WAIT_FOR_ALL_SERVOS(aTask)        SERVO_EASING_TASK_WAIT_UNTIL(aTask, !isOneServoMoving())
+#define SERVO_EASING_TASK_END(aTask)    } (aTask)->ResumeLine = 0; return true
+#endif
+
+/*
+ * If ENABLE_FRAME_SCHEDULER is defined, periodic jobs like NeoPixel show(), the HC-SR04 trigger or I2C flushes
+ * can be registered by addFrameJob() to be called by the servo timer interrupt, which then runs as long as jobs are registered.
+ * This interrupt is generated 100 us (or the margin set by setTimer1InterruptMarginMicros()) before a new servo period starts,
+ * i.e. after the pulses of the last period. Pulses of the Servo library start only after it returns,
+ * so even jobs which block interrupts do not distort a pulse, they only delay the start of the period.
+ * A job is called every PeriodFrames frames (of REFRESH_INTERVAL_MILLIS), first at frame OffsetFrames after adding,
+ * so jobs with the same period can be distributed over different frames to keep the load per frame low.
+ * The slot determines if the job is called before (FRAME_SLOT_BEFORE_SERVO_UPDATE) or after (FRAME_SLOT_AFTER_SERVO_UPDATE)
+ * updateAllServos() of this frame. The duration of each job and of each frame are measured and printed by printFrameSchedulerStatistics().
+ * Cannot be used together with ENABLE_EXTERNAL_SERVO_TIMER_HANDLER, which it replaces, and with the servo task or core 1 engine.
+ * Example:
+ * ServoEasingFrameJob NeoPixelJob;
+ * addFrameJob(&NeoPixelJob, &showNeoPixels, 2, 0, FRAME_SLOT_AFTER_SERVO_UPDATE); in setup() -> showNeoPixels() is called every 40 ms
+ */
+//#define ENABLE_FRAME_SCHEDULER
+#if defined(ENABLE_FRAME_SCHEDULER)
+#  if defined(ENABLE_EXTERNAL_SERVO_TIMER_HANDLER) || defined(ENABLE_ESP32_SERVO_TASK) || defined(ENABLE_RP2040_CORE1_SERVO_ENGINE)
+#error ENABLE_FRAME_SCHEDULER requires the handleServoTimerInterrupt() of ServoEasing called by the servo timer
+#  endif
+#  if !defined(FRAME_SCHEDULER_BUDGET_MICROS)
+#define FRAME_SCHEDULER_BUDGET_MICROS   REFRESH_INTERVAL_MICROS // Frames taking longer delay the next frame
+#  endif
+#define FRAME_SLOT_BEFORE_SERVO_UPDATE  0
+#define FRAME_SLOT_AFTER_SERVO_UPDATE   1
+struct ServoEasingFrameJob {
+    void (*JobFunction)();
+    uint8_t PeriodFrames;           // 1 -> called every frame
+    uint8_t FramesUntilNextCall;    // 0 -> called in the current frame
+    uint8_t Slot;                   // FRAME_SLOT_BEFORE_SERVO_UPDATE or FRAME_SLOT_AFTER_SERVO_UPDATE
+    // Measured load
+    uint16_t LastMicros;
+    uint16_t MaxMicros;
+    uint32_t SumOfMicros; // For average
+    uint16_t NumberOfCalls;
+    struct ServoEasingFrameJob *NextJob;
+};
+struct ServoEasingFrameSchedulerStatisticsStruct {
+    uint16_t LastFrameMicros; // Duration of the complete interrupt including updateAllServos()
+    uint16_t MaxFrameMicros;
+    uint32_t NumberOfFrames;
+    uint16_t NumberOfOverBudgetFrames; // Number of frames which took longer than FRAME_SCHEDULER_BUDGET_MICROS
+};
+#endif
+
+/*
+ * If ENABLE_SERVO_EASING_GROUPS is defined, servos can be collected in a ServoEasingGroup, which has its own next position array
+ * and its own set, synchronize, start, stop, pause and resume functions like the *AllServos*() functions.
+ * So the legs of a robot can be synchronized independently, each group with the cost of its own size.
+ * All groups are still updated by the one servo timer interrupt or updateAllServos(). A servo should be member of only one group.
+ * Example:
+ * ServoEasingGroup LeftLeg;
+ * LeftLeg.addServo(Servo1); LeftLeg.addServo(Servo2); in setup()
+ * LeftLeg.NextPositionArray[0] = 90; LeftLeg.NextPositionArray[1] = 45; LeftLeg.setEaseToSynchronizeAndStartInterrupt(60);
+ */
+//#define ENABLE_SERVO_EASING_GROUPS
+#if defined(ENABLE_SERVO_EASING_GROUPS)
+#  if !defined(MAX_SERVOS_PER_GROUP)
+#define MAX_SERVOS_PER_GROUP    8 // Each entry requires one ServoEasingPositionType and one servo pointer
+#  endif
+#endif
+
+/*
+ * If ENABLE_WRITE_DEADBAND is defined, update() writes an intermediate position only if it differs
+ * by more than the deadband set by setWriteDeadband() from the last written value. The end position is always written exactly.
+ * For slow moves, this avoids a write (and an I2C transmission for PCA9685) in each frame for a change, which the servo can not resolve.
+ * The deadband is specified in microseconds or PCA9685 units, the default of 0 writes each change.
+ */
+//#define ENABLE_WRITE_DEADBAND
+
+/*
+ * If ENABLE_SERVO_FEEDBACK is defined, a servo with an analog position feedback (the voltage of its potentiometer)
+ * can be set to closed loop mode by setFeedback(). Then the position computed by update() is only the setpoint
+ * and an integer PI corrector adds a correction to the written pulse, based on the difference
+ * between setpoint and measured position. The measured ADC value is mapped to the position by the ADC values
+ * given for 0 and 180 degree, so it must be available without blocking, e.g. by getADCBackgroundValue() of ADCUtils.
+ * At the end of a move, the end position is held until the servo is within FEEDBACK_TOLERANCE_MICROSECONDS_OR_UNITS
+ * or FEEDBACK_SETTLE_MILLIS have passed. Servos with feedback are not processed by the packed update kernel.
+ */
+//#define ENABLE_SERVO_FEEDBACK
+#if defined(ENABLE_SERVO_FEEDBACK)
+#define FEEDBACK_GAIN_SHIFT                         4 // Gains are in 1/16, i.e. a gain of 16 is a factor of 1
+#  if !defined(DEFAULT_FEEDBACK_PROPORTIONAL_GAIN)
+#define DEFAULT_FEEDBACK_PROPORTIONAL_GAIN          8 // 0.5
+#  endif
+#  if !defined(DEFAULT_FEEDBACK_INTEGRAL_GAIN)
+#define DEFAULT_FEEDBACK_INTEGRAL_GAIN              2 // 0.125 per update
+#  endif
+#  if !defined(FEEDBACK_MAX_CORRECTION_MICROSECONDS_OR_UNITS)
+#define FEEDBACK_MAX_CORRECTION_MICROSECONDS_OR_UNITS   100 // Around 18 degree for microseconds, use 20 for PCA9685 units
+#  endif
+#  if !defined(FEEDBACK_TOLERANCE_MICROSECONDS_OR_UNITS)
+#define FEEDBACK_TOLERANCE_MICROSECONDS_OR_UNITS    5
+#  endif
+#  if !defined(FEEDBACK_SETTLE_MILLIS)
+#define FEEDBACK_SETTLE_MILLIS                      300 // Maximum time after end of move to reach the tolerance
+#  endif
+#endif
+
+/*
+ * If ENABLE_STALL_DETECTION is defined, the current of a servo can be checked by setStallDetection() in each update() of a move.
+ * If the current is above the threshold for the given number of consecutive frames, the move is stopped or paused,
+ * or stopped and the servo is detached to switch off its signal. Then the handler set by setStallHandler() is called.
+ * The stall is detected by update(), but the action is taken by updateAllServos() after all servos of the frame are updated,
+ * so a detach() does not change the servo lists while they are processed.
+ * The pause flag is then not packed for ENABLE_COMPACT_SERVO_LAYOUT, since it is written by the interrupt.
+ * The current value must be available without blocking, e.g. by getADCBackgroundValue() of ADCUtils for the voltage at a shunt.
+ * Cost is one call of the value function and one compare per moving servo and frame.
+ * Servos with stall detection are not processed by the packed update kernel.
+ */
+//#define ENABLE_STALL_DETECTION
+#if defined(ENABLE_STALL_DETECTION)
+#define STALL_ACTION_STOP       0
+#define STALL_ACTION_PAUSE      1 // Continue with resumeWithInterrupts() or resumeWithoutInterrupts(). Like stop for DISABLE_PAUSE_RESUME and PROVIDE_ONLY_LINEAR_MOVEMENT.
+#define STALL_ACTION_DETACH     2 // Stop and switch signal fully off. Call attach() to use the servo again.
+#endif
+
+/*
+ * If ENABLE_REACTIVE_SOURCE is defined, a servo can be bound by setReactiveSource() to a sensor value,
+ * e.g. an ultrasonic distance, an analog value or the last IR command.
+ * In each frame, update() maps the latest value of the source linear to the given degree range and moves the servo towards it,
+ * limited by the given speed. So the servo reacts to a change of the sensor value within one frame,
+ * instead of after the next loop() iteration and the end of a blocking move.
+ * The value function must not block, e.g. getADCBackgroundValue() of ADCUtils or a function returning a value stored by an ISR.
+ * If it returns REACTIVE_SOURCE_NO_VALUE, e.g. for a timeout of an ultrasonic measurement, the servo keeps its position.
+ * A bound servo is moving until disableReactiveSource(), stop() or stopAllServos() is called, so do not wait for it to stop.
+ * Moves started for a bound servo are ignored. Bound servos are not processed by the packed update kernel.
+ */
+//#define ENABLE_REACTIVE_SOURCE
+#if defined(ENABLE_REACTIVE_SOURCE)
+#define REACTIVE_SOURCE_NO_VALUE    0xFFFF
+#endif
+
+/*
+ * If ENABLE_VELOCITY_MODE is defined, a continuous rotating servo can be controlled by its speed instead of by position moves.
+ * setVelocity() sets the target speed in the units used for attach(), e.g. -100 to 100 for the attach() of the ContinuousRotatingServo example.
+ * In each frame, update() ramps the current speed towards the target by at most the given speed change per second.
+ * If an encoder tick counter is set by setVelocityEncoder(), the target is given in RPM by setVelocityRPM()
+ * and the pulse is corrected by an integral controller every VELOCITY_ENCODER_MEASUREMENT_MILLIS, using the ticks counted in this time.
+ * The counter is incremented by the encoder ISR of your program and must be decremented for the reverse direction.
+ * A servo in velocity mode is moving until disableVelocityMode(), stop() or stopAllServos() is called, so do not wait for it to stop.
+ * Moves started for a servo in velocity mode are ignored. Servos in velocity mode are not processed by the packed update kernel.
+ */
+//#define ENABLE_VELOCITY_MODE
+#if defined(ENABLE_VELOCITY_MODE)
+#  if !defined(VELOCITY_ENCODER_MEASUREMENT_MILLIS)
+#define VELOCITY_ENCODER_MEASUREMENT_MILLIS 200 // Measurement interval for setVelocityRPM()
+#  endif
+#  if !defined(VELOCITY_ENCODER_GAIN)
+#define VELOCITY_ENCODER_GAIN               32  // Correction per measurement in 1/256 microseconds or units per RPM difference
+#  endif
+#endif
+
+/*
+ * If ENABLE_CALIBRATION_TABLE is defined, a nonlinear servo can be corrected by a table of 2 to CALIBRATION_TABLE_MAX_POINTS corrections
+ * set by setCalibrationTable(). The corrections are in microseconds or PCA9685 units and are added to the output value
+ * after trim and reverse. They are equally spaced from the 0 degree to the 180 degree value of the not reversed servo
+ * and linear interpolated with integer arithmetic in each write. E.g. 9 points give one correction every 22.5 degree.
+ * If CALIBRATION_TABLE_EEPROM_ADDRESS is defined, the table of each servo is read from EEPROM at attach()
+ * and can be stored by eepromWriteCalibrationTable(). Each servo uses CALIBRATION_TABLE_EEPROM_BYTES_PER_SERVO bytes
+ * starting at CALIBRATION_TABLE_EEPROM_ADDRESS + (servo index * CALIBRATION_TABLE_EEPROM_BYTES_PER_SERVO).
+ * The first byte is the number of points, an erased EEPROM (0xFF) keeps the table set before. The EEPROM functions are only available for AVR.
+ * Requires CALIBRATION_TABLE_MAX_POINTS + 1 bytes RAM per servo.
+ */
+//#define ENABLE_CALIBRATION_TABLE
+#if defined(ENABLE_CALIBRATION_TABLE)
+#  if !defined(CALIBRATION_TABLE_MAX_POINTS)
+#define CALIBRATION_TABLE_MAX_POINTS    17
+#  endif
+//#define CALIBRATION_TABLE_EEPROM_ADDRESS 0
+#  if defined(CALIBRATION_TABLE_EEPROM_ADDRESS)
+#    if !defined(__AVR__)
+#undef CALIBRATION_TABLE_EEPROM_ADDRESS
+#    else
+#define CALIBRATION_TABLE_EEPROM_BYTES_PER_SERVO    (CALIBRATION_TABLE_MAX_POINTS + 1)
+#    endif
+#  endif
+#endif
+
+/*
+ * If ENABLE_IDLE_POWER_DOWN is defined, the output of a servo, which was not written for the time set by setIdleTimeout(),
+ * is switched off by checkForIdleServos(). This saves power and heat of servos just holding their position
+ * and I2C transfers for PCA9685 expanders. The next write, e.g. by the next move, switches the output on again
+ * with the current position, without calling attach().
+ * PCA9685: full off bit set. LightweightServo: compare output disabled. SortedSoftServo and HardwareServo: pulse of 0 us.
+ * Servo library: Servo::detach(), and Servo::attach() with the stored 0 and 180 degree values at the next write.
+ * checkForIdleServos() is called by updateAllServos() and should be called in loop(), since the servo interrupt stops after all servos stopped.
+ * Be aware, that an unpowered servo can be moved by external forces.
+ */
+//#define ENABLE_IDLE_POWER_DOWN
+
+/*
+ * If ENABLE_UPDATE_STATISTICS is defined, each call of updateAllServos() (and therefore of the servo timer interrupt) is measured.
+ * The last, maximum and average duration, the number of servo writes and of I2C bytes per update
+ * and the number of updates, which took longer than UPDATE_BUDGET_MICROS are stored in ServoEasing::sUpdateStatistics.
+ * Use printUpdateStatistics() to print them and resetUpdateStatistics() to restart the measurement.
+ * Requires 24 bytes RAM and 2 micros() calls per update.
+ */
+//#define ENABLE_UPDATE_STATISTICS
+#if defined(ENABLE_UPDATE_STATISTICS)
+#  if !defined(UPDATE_BUDGET_MICROS)
+#define UPDATE_BUDGET_MICROS    REFRESH_INTERVAL_MICROS // Can be reduced e.g. to the time the first servo pulse of the Servo library can be delayed
+#  endif
+#endif
+
+/*
+ * If ENABLE_TELEMETRY_BUFFER is defined, each servo write of updateAllServos() stores a compact binary record
+ * (frame number, servo index, flags and written value) in a lock free ring buffer, instead of printing inside the interrupt
+ * as PRINT_FOR_SERIAL_PLOTTER does. Call writeTelemetryRecords() in loop() to send the records in bulk to Serial.
+ * Each record is sent as 7 bytes: TELEMETRY_RECORD_SYNC_BYTE, frame number (16 bit), servo index, flags, value (16 bit),
+ * all little endian. Use extras/DecodeServoEasingTelemetry.py to decode them on the host.
+ * If the buffer is full, records are discarded and the next stored record gets the flag TELEMETRY_FLAG_RECORDS_LOST.
+ * Requires 6 bytes RAM per record.
+ */
+//#define ENABLE_TELEMETRY_BUFFER
+#if defined(ENABLE_TELEMETRY_BUFFER)
+#  if defined(PRINT_FOR_SERIAL_PLOTTER)
+#error ENABLE_TELEMETRY_BUFFER replaces PRINT_FOR_SERIAL_PLOTTER, do not use both
+#  endif
+#  if !defined(TELEMETRY_BUFFER_SIZE)
+#define TELEMETRY_BUFFER_SIZE       64 // Must be a power of 2 and not greater than 128. One entry is always kept free.
+#  endif
+#define TELEMETRY_RECORD_SYNC_BYTE  0xA5
+#define TELEMETRY_FLAG_MOVING       0x01 // Servo was moving, i.e. value was computed by update()
+#define TELEMETRY_FLAG_CONSTRAINED  0x02 // Value was limited by min or max constraint
+#define TELEMETRY_FLAG_RECORDS_LOST 0x80 // Records were discarded before this record, since the buffer was full
+#endif
+
+/*
+ * If ENABLE_TRACE_POINTS is defined, updateAllServos() records time stamps at the trace points below in a static buffer.
+ * startTrace() clears the buffer and the next frames are recorded until the buffer is full.
+ * Then printTrace() prints one CSV line per trace point and printChromeTrace() prints a JSON file,
+ * which can be loaded by chrome://tracing or https://ui.perfetto.dev to see where the microseconds of each frame go.
+ * The time stamp is the cycle counter for ESP32 and Cortex-M3 and higher (DWT), otherwise micros(), which has 4 us resolution on AVR.
+ * A trace point costs only two stores and an increment, instead of the milliseconds of a LOCAL_TRACE print.
+ * If not defined, the trace points are compiled to nothing.
+ * Requires 6 bytes RAM per entry for AVR and 8 bytes for 32 bit platforms.
  */
+//#define ENABLE_TRACE_POINTS
+#if defined(ENABLE_TRACE_POINTS)
+#  if !defined(TRACE_BUFFER_SIZE)
+#define TRACE_BUFFER_SIZE           64 // Number of entries. Must not be greater than 255.
+#  endif
+#define TRACE_POINT_FRAME_START     0 // Start of updateAllServos()
+#define TRACE_POINT_SERVO_UPDATE    1 // Start of update() of a moving servo
+#define TRACE_POINT_WRITE_SUBMITTED 2 // _writeMicrosecondsOrUnits() starts the hardware write or the I2C transmission
+#define TRACE_POINT_WRITE_DONE      3 // Hardware write or I2C transmission is done. The value may still be staged for ENABLE_PCA9685_FRAME_COMMIT.
+#define TRACE_POINT_I2C_FLUSH_DONE  4 // All staged PCA9685 values are sent by flushPCA9685FrameBuffers()
+#define TRACE_POINT_CALLBACK        5 // The target position reached handler is invoked
+#define TRACE_POINT_FRAME_END       6 // End of updateAllServos()
+#endif
+
+/*
+ * If ENABLE_LATENCY_MEASUREMENT is defined, the time from write() or a startEaseTo() with a changed position
+ * to the first write of a new value to the servo library or PCA9685 is measured and counted in a histogram for each backend.
+ * The backends are the servo library used for pins and, if USE_PCA9685_SERVO_EXPANDER is defined, the PCA9685 with Wire or SoftI2CMaster.
+ * For ENABLE_PCA9685_FRAME_COMMIT, the value is committed at the end of the I2C transfer of flushPCA9685FrameBuffers().
+ * The servo libraries and the PCA9685 take the new value at the start of the next pulse period of this output,
+ * which cannot be read from the hardware, so the pulse with the new value starts up to REFRESH_INTERVAL_MICROS after the commit.
+ * Use printLatencyHistograms() to print them and resetLatencyHistograms() to restart the measurement.
+ * Requires 44 bytes RAM per backend and 5 bytes per servo.
+ */
+//#define ENABLE_LATENCY_MEASUREMENT
+#if defined(ENABLE_LATENCY_MEASUREMENT)
+#  if !defined(LATENCY_HISTOGRAM_BIN_MICROS)
+#define LATENCY_HISTOGRAM_BIN_MICROS    2500 // The bins cover 0 to 40 ms, the last bin contains all greater latencies
+#  endif
+#define LATENCY_HISTOGRAM_BINS          16
+#define LATENCY_BACKEND_PIN             0
+#  if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_SERVO_LIB)
+#define LATENCY_BACKEND_PCA9685         1
+#define LATENCY_NUMBER_OF_BACKENDS      2
+#  else
+#define LATENCY_BACKEND_PCA9685         0 // Only one backend is used
+#define LATENCY_NUMBER_OF_BACKENDS      1
+#  endif
+#define LATENCY_STATE_IDLE              0
+#define LATENCY_STATE_COMMANDED         1 // Command is given, but no value is written yet
+#define LATENCY_STATE_STAGED            2 // Value is written to the PCA9685 frame buffer, but not yet sent
+#endif
+
 // Offset to decide if the user function returns degrees instead of 0.0 to 1.0.
 #define EASE_FUNCTION_DEGREE_INDICATOR_OFFSET       200 // Returns 20 for -180, 110 for -90, 200 for 0 and 380 for 180.
 #define EASE_FUNCTION_DEGREE_THRESHOLD              (EASE_FUNCTION_DEGREE_INDICATOR_OFFSET - 180) // allows -180.
@@ -285,6 +1442,9 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 
 #define CALL_STYLE_MASK         0xC0
 #define EASE_TYPE_MASK          0x0F
+// The EASE types, which are computed by the polynomial t^(EASE_TYPE + 1)
+#define POLYNOMIAL_FIRST_EASE_TYPE  0x01 // EASE_QUADRATIC_IN
+#define POLYNOMIAL_LAST_EASE_TYPE   0x03 // EASE_QUARTIC_IN
 
 #define EASE_LINEAR             0x00 // No bouncing available
 
@@ -317,6 +1477,13 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 #define EASE_USER_BOUNCING      0xC6
 #endif
 
+#if defined(ENABLE_EASE_TRAPEZOIDAL)
+#define EASE_TRAPEZOIDAL        0x04 // Only direct call style
+#endif
+#if defined(ENABLE_EASE_S_CURVE)
+#define EASE_S_CURVE            0x05 // Only direct call style
+#endif
+
 #define EASE_DUMMY_MOVE         0x07 // can be used as delay
 
 #if defined(ENABLE_EASE_SINE)
@@ -358,6 +1525,13 @@ __attribute__((weak)) extern void handleServoTimerInterrupt();
 #define EASE_PRECISION_OUT      0x4D // Positive bounce for movings from below (go out from origin)
 #endif
 
+#if defined(ENABLE_EASE_TABLE)
+#define EASE_TABLE_IN           0x0E // The curve of the table registered by registerEaseTable()
+#define EASE_TABLE_OUT          0x4E
+#define EASE_TABLE_IN_OUT       0x8E
+#define EASE_TABLE_BOUNCING     0xCE
+#endif
+
 // !!! Must be without comment and closed by @formatter:on !!!
 // @formatter:off
 extern const char easeTypeLinear[]     PROGMEM;
@@ -368,6 +1542,15 @@ extern const char easeTypeQuartic[]    PROGMEM;
 extern const char easeTypePrecision[]  PROGMEM;
 extern const char easeTypeUser[]       PROGMEM;
 extern const char easeTypeDummy[]      PROGMEM;
+#  if defined(ENABLE_EASE_TRAPEZOIDAL)
+extern const char easeTypeTrapezoidal[] PROGMEM;
+#  endif
+#  if defined(ENABLE_EASE_S_CURVE)
+extern const char easeTypeSCurve[] PROGMEM;
+#  endif
+#  if defined(ENABLE_EASE_TABLE)
+extern const char easeTypeTable[] PROGMEM;
+#  endif
 #  if !defined(DISABLE_COMPLEX_FUNCTIONS)
 extern const char easeTypeSine[]       PROGMEM;
 extern const char easeTypeCircular[]   PROGMEM;
@@ -381,6 +1564,7 @@ extern const char *const easeTypeStrings[] PROGMEM;
 
 // some PCA9685 specific constants
 #define PCA9685_GENERAL_CALL_ADDRESS 0x00
+#define PCA9685_ALLCALL_ADDRESS      0x70 // Power on default, all PCA9685 of the bus respond to it. Do not use it as board address!
 #define PCA9685_SOFTWARE_RESET          6
 #define PCA9685_DEFAULT_ADDRESS      0x40
 #define PCA9685_MAX_CHANNELS           16 // 16 PWM channels on each PCA9685 expansion module
@@ -388,10 +1572,134 @@ extern const char *const easeTypeStrings[] PROGMEM;
 #define PCA9685_MODE_1_RESTART          7
 #define PCA9685_MODE_1_AUTOINCREMENT    5
 #define PCA9685_MODE_1_SLEEP            4
+#define PCA9685_MODE_1_ALLCALL          0
+#define PCA9685_MODE_1_VALUE_AFTER_INIT (_BV(PCA9685_MODE_1_AUTOINCREMENT) | _BV(PCA9685_MODE_1_ALLCALL)) // Set by PCA9685Init()
+#define PCA9685_OFF_H_FULL_OFF_BIT      4 // Set for all channels after power on
 #define PCA9685_FIRST_PWM_REGISTER   0x06
+#define PCA9685_ALL_LED_ON_L_REGISTER 0xFA // Writing ALL_LED registers sets the registers of all 16 channels
+#define PCA9685_FULL_OFF_VALUE       4096 // Bit 4 of LED_OFF_H register, output is fully off
 #define PCA9685_PRESCALE_REGISTER    0xFE
 
 #define PCA9685_PRESCALER_FOR_20_MS ((25000000L /(4096L * 50))-1) // = 121 / 0x79 at 50 Hz
+#define PCA9685_PRESCALER_FOR_REFRESH_INTERVAL ((25000000L /(4096L * REFRESH_FREQUENCY))-1) // = 121 at 50 Hz, 29 at 200 Hz
+#if REFRESH_INTERVAL_MICROS == 20000
+#define PCA9685_PERIOD_MICROS   20000L // Keep the nominal value, the error of the internal oscillator is bigger than the 0.06% error of the prescaler
+#else
+// The prescaler is an integer, so the real period deviates from REFRESH_INTERVAL_MICROS, by 1.7% at 200 Hz.
+#define PCA9685_PERIOD_MICROS   (((4096L * (PCA9685_PRESCALER_FOR_REFRESH_INTERVAL + 1)) + 12) / 25) // 25 MHz clock, e.g. 4915 for 5000 us
+#endif
+
+#if defined(USE_PCA9685_SERVO_EXPANDER)
+/*
+ * Registry entry and shadow buffer for one PCA9685 board.
+ * The PWM registers are stored in the same order as in the PCA9685 (ON_L, ON_H, OFF_L, OFF_H for each channel),
+ * so consecutive channels can be sent directly from this buffer with one auto increment transmission.
+ */
+struct PCA9685ExpanderStruct {
+    uint8_t I2CAddress;
+#  if !defined(USE_SOFT_I2C_MASTER)
+    TwoWire *I2CClass;
+#  endif
+#  if defined(ENABLE_PCA9685_FRAME_COMMIT)
+    uint16_t DirtyChannelMask; // Bit n is set, if channel n has a new value, which is not yet sent
+    uint16_t ValidChannelMask; // Bit n is set, if the buffer for channel n contains the values of the PCA9685 registers (after flush)
+                               // Always 0xFFFF for ENABLE_PCA9685_RESET_RECOVERY
+    uint8_t PWMRegisters[PCA9685_MAX_CHANNELS * 4];
+#  endif
+};
+#endif
+
+#if defined(ENABLE_MOTION_QUEUE) || defined(ENABLE_SERVO_MAILBOX)
+/*
+ * One queued or posted move
+ */
+struct ServoEasingMoveStruct {
+    int16_t TargetDegreeOrMicrosecond;
+    uint16_t MillisForMoveOrDegreesPerSecond;
+    bool IsSpeed; // true if MillisForMoveOrDegreesPerSecond contains degrees per second
+#  if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+    uint8_t EasingType;
+#  endif
+};
+#endif
+
+#if defined(ENABLE_EASE_S_CURVE)
+/*
+ * The first half of the S-curve in Q15 format, the second half is point symmetric.
+ * The time of segment ends are fractions of the duration of the move, the positions are fractions of the complete move.
+ */
+struct ServoEasingSCurveSegmentsStruct {
+    uint16_t SegmentEnd[3]; // End of jerk up, constant acceleration and jerk down segment
+    uint16_t SegmentEndPosition[3]; // Factor of movement completion at SegmentEnd
+    uint16_t ConstantAccelerationStartDelta; // Movement of the constant acceleration segment caused by its start speed
+};
+#endif
+
+#if defined(ENABLE_POSITION_FRAME_RECEIVER)
+struct ServoEasingPositionFrameReceiverStruct {
+    uint8_t State;
+    uint8_t ByteIndex; // Index of byte in header or in target value
+    uint8_t ServoIndex; // Index of the next target value
+    uint8_t CRC;
+    bool IsEscaped; // Last byte was POSITION_FRAME_ESCAPE_BYTE
+    uint8_t Flags;
+    uint32_t ServoMask;
+    uint16_t MillisForMove;
+    int16_t TargetValues[MAX_EASING_SERVOS]; // Values of the frame currently received, copied to ServoEasingNextPositionArray if CRC is valid
+    // Received frame, which is not yet started
+    volatile bool FrameIsPending;
+    uint8_t PendingFlags;
+    uint32_t PendingServoMask;
+    uint16_t PendingMillisForMove;
+    // Counters
+    uint16_t NumberOfFrames;
+    uint16_t NumberOfCRCErrors;
+    uint16_t NumberOfOverruns; // Frames discarded since the previous frame was not yet started
+};
+#endif
+
+#if defined(ENABLE_TELEMETRY_BUFFER)
+struct ServoEasingTelemetryRecordStruct {
+    uint16_t FrameNumber; // Incremented by each updateAllServos()
+    uint8_t ServoIndex;
+    uint8_t Flags; // TELEMETRY_FLAG_MOVING, TELEMETRY_FLAG_CONSTRAINED, TELEMETRY_FLAG_RECORDS_LOST
+    int16_t MicrosecondsOrUnits; // Value written to the servo, including trim and reverse
+};
+#endif
+
+#if defined(ENABLE_TRACE_POINTS)
+struct ServoEasingTraceEntryStruct {
+    uint32_t Timestamp; // Cycles or microseconds, see TRACE_TIMESTAMP_TICKS_PER_MICROSECOND
+    uint8_t TracePoint;  // TRACE_POINT_FRAME_START etc.
+    uint8_t ServoIndex;  // INVALID_SERVO for frame trace points
+};
+#endif
+
+#if defined(ENABLE_LATENCY_MEASUREMENT)
+struct ServoEasingLatencyHistogramStruct {
+    uint16_t Counts[LATENCY_HISTOGRAM_BINS];
+    uint16_t NumberOfMeasurements;
+    uint32_t MaxMicros;
+    uint32_t SumOfMicros; // For average
+};
+#endif
+
+#if defined(ENABLE_UPDATE_STATISTICS)
+struct ServoEasingUpdateStatisticsStruct {
+    uint16_t LastUpdateMicros;
+    uint16_t MaxUpdateMicros;
+    uint32_t SumOfUpdateMicros; // For average
+    uint32_t NumberOfUpdates;
+    uint16_t NumberOfOverBudgetUpdates; // Number of updates which took longer than UPDATE_BUDGET_MICROS
+    uint8_t LastNumberOfServoWrites;
+    uint8_t MaxNumberOfServoWrites;
+    uint16_t LastNumberOfI2CBytes; // including the address byte
+    uint16_t MaxNumberOfI2CBytes;
+    // Counters for the current update
+    uint8_t NumberOfServoWrites;
+    uint16_t NumberOfI2CBytes;
+};
+#endif
 
 // to be used as values for parameter bool aStartUpdateByInterrupt
 #define START_UPDATE_BY_INTERRUPT           true
@@ -401,7 +1709,8 @@ extern const char *const easeTypeStrings[] PROGMEM;
  * Size is 46 bytes RAM per servo
  */
 class ServoEasing
-#if (!defined(USE_PCA9685_SERVO_EXPANDER) || defined(USE_SERVO_LIB)) && !defined(USE_LEIGHTWEIGHT_SERVO_LIB)
+#if (!defined(USE_PCA9685_SERVO_EXPANDER) || defined(USE_SERVO_LIB)) && !defined(USE_LEIGHTWEIGHT_SERVO_LIB) \
+    && !defined(USE_SORTED_SOFT_SERVO_LIB) && !defined(USE_HARDWARE_SERVO_LIB) && !defined(ENABLE_SIMULATION_MODE)
         : public Servo
 #endif
 {
@@ -420,9 +1729,20 @@ public:
     void I2CInit();
     void PCA9685Reset();
     void PCA9685Init();
+    bool registerPCA9685Expander();
     void I2CWriteByte(uint8_t aAddress, uint8_t aData);
     void setPWM(uint16_t aPWMOffValueAsUnits);
     void setPWM(uint16_t aPWMOnStartValueAsUnits, uint16_t aPWMPulseDurationAsUnits);
+    // Broadcast writes, affected servos are stopped. Trim and reverse of the other servos are not applied.
+    void writeAllChannelsOfPCA9685(int aTargetDegreeOrMicrosecond); // all 16 channels of the board of this servo
+    void writeAllPCA9685Expanders(int aTargetDegreeOrMicrosecond);  // all channels of all boards at the I2C bus of this servo
+    void writePCA9685Broadcast(uint8_t aI2CAddress, uint16_t aPWMOffValueAsUnits);
+    void adoptPCA9685BroadcastValue(uint16_t aPWMOffValueAsUnits);
+    bool isAtSamePCA9685Bus(ServoEasing *aServo);
+#  if defined(ENABLE_PCA9685_WRITE_BUDGET)
+    void setWritePriority(uint8_t aWritePriority); // SERVO_WRITE_PRIORITY_LOW or SERVO_WRITE_PRIORITY_HIGH
+    bool consumePCA9685WriteBudget(int aMicrosecondsOrUnits);
+#  endif
     // main mapping functions for us to PCA9685 Units (20000/4096 = 4.88 us) and back
     int MicrosecondsToPCA9685Units(int aMicroseconds);
     int PCA9685UnitsToMicroseconds(int aPCA9685Units);
@@ -459,19 +1779,50 @@ public:
 
 #if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
     void setEasingType(uint_fast8_t aEasingType);
+#  if defined(ENABLE_EASING_TEMPLATES)
+    template<uint_fast8_t tEasingType> void setEasingType();
+#  endif
     uint_fast8_t getEasingType();
 
     float callEasingFunction(float aPercentageOfCompletion);            // used in update()
+#  if defined(USE_FIXED_POINT_EASING)
+    uint_fast16_t callFixedPointEasingFunction(uint_fast16_t aFactorOfTimeCompletionQ15); // used in update()
+    uint_fast16_t getFixedPointFactorOfMovementCompletion(uint32_t aMillisSinceStart);
+#  endif
+#  if defined(ENABLE_EASE_TRAPEZOIDAL)
+    uint_fast16_t getTrapezoidalMillisForCompleteMove(uint_fast16_t aDegrees, uint_fast16_t aDegreesPerSecond); // used in startEaseTo()
+    void setTrapezoidalAccelerationFraction(); // used in startEaseToD()
+    uint_fast16_t getTrapezoidalFactorOfMovementCompletion(uint32_t aMillisSinceStart); // used in update()
+#  endif
+#  if defined(ENABLE_EASE_S_CURVE)
+    uint_fast16_t getSCurveMillisForCompleteMove(uint_fast16_t aDegrees, uint_fast16_t aDegreesPerSecond); // used in startEaseTo()
+    void setSCurveSegments(); // used in startEaseToD()
+    void computeSCurveSegments(int aStartMicrosecondsOrUnits, int aEndMicrosecondsOrUnits, uint32_t aMillisForCompleteMove,
+            ServoEasingSCurveSegmentsStruct *aSCurveSegments); // used in setSCurveSegments() and by the batched move setup
+    uint_fast16_t getSCurveFactorOfMovementCompletion(uint32_t aMillisSinceStart); // used in update()
+#  endif
+#  if defined(ENABLE_FORWARD_DIFFERENCING)
+    int getForwardDifferencingMicrosecondsOrUnits(uint32_t aMillisSinceStart); // used in update()
+    void initForwardDifferences(uint32_t aMillisSinceStart, bool aIsSecondHalf);
+#  endif
 
 #  if defined(ENABLE_EASE_USER)
     void registerUserEaseInFunction(float (*aUserEaseInFunction)(float aPercentageOfCompletion, void *aUserDataPointer),
             void *aUserDataPointer = NULL);
     void setUserDataPointer(void *aUserDataPointer);
 #  endif
+#  if defined(ENABLE_EASE_TABLE)
+    void registerEaseTable(const int16_t *aEaseTablePGM);
+    int32_t getEaseTableFactorOfMovementCompletion(uint32_t aMillisSinceStart); // used in update()
+    int32_t callEaseTable(uint_fast16_t aFactorOfTimeCompletionQ15);
+#  endif
 #endif
 
     void write(int aTargetDegreeOrMicrosecond);     // Apply trim and reverse to the value and write it direct to the Servo library.
     void _writeMicrosecondsOrUnits(int aTargetDegreeOrMicrosecond);
+#if defined(ENABLE_SIMULATION_MODE)
+    void recordSimulatedWrite(int aMicroseconds);
+#endif
 
     void easeTo(int aTargetDegreeOrMicrosecond);                                   // blocking move to new position using mLastSpeed
     void easeTo(int aTargetDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond);  // blocking move to new position using speed
@@ -501,19 +1852,149 @@ public:
     bool setEaseToD(float aTargetDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond);   // shortcut for startEaseToD(..,..,DO_NOT_START_UPDATE_BY_INTERRUPT)
     bool startEaseToD(float aTargetDegreeOrMicrosecond, uint_fast16_t aMillisForMove, bool aStartUpdateByInterrupt =
     START_UPDATE_BY_INTERRUPT);
+#if defined(USE_FIXED_POINT_MOVE_SETUP)
+    uint_fast16_t computeMillisForCompleteMove(int aTargetMicrosecondsOrUnits, uint_fast16_t aDegreesPerSecond); // used in startEaseTo()
+    bool startEaseToMicrosecondsOrUnits(int aTargetMicrosecondsOrUnits, ServoEasingPositionType aTargetDegreeOrMicrosecond,
+            uint_fast16_t aMillisForMoveOrDegreesPerSecond, bool aIsSpeed, bool aStartUpdateByInterrupt,
+            bool aSCurveSegmentsAreSet = false); // used by startEaseTo() and startEaseToD()
+#endif
 
     bool noMovement(uint_fast16_t aMillisToWait);                                       // stay at the position for aMillisToWait
 
+#if defined(ENABLE_RETARGET)
+    // Change the target of a running move and keep its current speed
+    bool retarget(int aTargetDegreeOrMicrosecond);                                      // shortcut for retarget(aDegree, mSpeed, START_UPDATE_BY_INTERRUPT)
+    bool retarget(int aTargetDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond, bool aStartUpdateByInterrupt =
+    START_UPDATE_BY_INTERRUPT);
+    int constrainToServoRange(int aMicrosecondsOrUnits);
+    void startPendingRetargetMove(); // used by update()
+#endif
+#if defined(ENABLE_SPLINE_PATH)
+    // Move smoothly through all waypoints. Each segment between two waypoints lasts aMillisPerSegment.
+    bool setSplinePath(const int *aWaypointDegreesOrMicroseconds, uint8_t aNumberOfWaypoints, uint_fast16_t aMillisPerSegment); // shortcut for startSplinePath(..,..,..,DO_NOT_START_UPDATE_BY_INTERRUPT)
+    bool startSplinePath(const int *aWaypointDegreesOrMicroseconds, uint8_t aNumberOfWaypoints, uint_fast16_t aMillisPerSegment,
+            bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+    int getSplinePointMicrosecondsOrUnits(int_fast16_t aPointIndex);
+    void setSplineSegmentCoefficients();
+    void startNextSplineSegment(); // used by update()
+#endif
+
+#if defined(ENABLE_MOTION_QUEUE)
+    // Append move to queue. Start move directly, if servo is not moving. Return false if queue is full.
+    bool queueEaseTo(int aTargetDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond, bool aStartUpdateByInterrupt =
+    START_UPDATE_BY_INTERRUPT);
+    bool queueEaseToD(int aTargetDegreeOrMicrosecond, uint_fast16_t aMillisForMove, bool aStartUpdateByInterrupt =
+    START_UPDATE_BY_INTERRUPT);
+    bool queueMove(int aTargetDegreeOrMicrosecond, uint_fast16_t aMillisForMoveOrDegreesPerSecond, bool aIsSpeed,
+            bool aStartUpdateByInterrupt);
+    uint_fast8_t getNumberOfQueuedMoves();
+    void clearMotionQueue();
+    void handleMotionQueueClearRequest(); // used in update()
+    void startNextQueuedMove();
+#endif
+#if defined(ENABLE_SERVO_MAILBOX)
+    // Post move to mailbox, it is started by the next updateAllServos(). Replaces a posted move, which is not yet started.
+    void postEaseTo(int aTargetDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond);
+    void postEaseToD(int aTargetDegreeOrMicrosecond, uint_fast16_t aMillisForMove);
+    void postMove(int aTargetDegreeOrMicrosecond, uint_fast16_t aMillisForMoveOrDegreesPerSecond, bool aIsSpeed);
+    bool isMovePosted();
+    bool startPostedMove();
+#endif
+
     void setSpeed(uint_fast16_t aDegreesPerSecond);                            // This speed is taken if no speed argument is given.
+#if defined(ENABLE_EASE_TRAPEZOIDAL)
+    void setMaxAcceleration(uint_fast16_t aDegreesPerSecondSquare);            // Acceleration limit for EASE_TRAPEZOIDAL. 0 -> linear movement.
+#endif
+#if defined(ENABLE_EASE_S_CURVE)
+    void setMaxJerk(uint_fast16_t aDegreesPerSecondCubed);                     // Jerk limit for EASE_S_CURVE. 0 -> EASE_TRAPEZOIDAL profile.
+#endif
     uint_fast16_t getSpeed();
+#if defined(ENABLE_WRITE_DEADBAND)
+    void setWriteDeadband(uint8_t aDeadbandMicrosecondsOrUnits);                // Intermediate changes up to this value are not written
+#endif
+#if defined(ENABLE_SERVO_FEEDBACK)
+    void setFeedback(uint16_t (*aGetFeedbackValueFunction)(uint8_t aFeedbackIndex), uint8_t aFeedbackIndex, uint16_t aValueFor0Degree,
+            uint16_t aValueFor180Degree);
+    void setFeedbackGains(uint8_t aProportionalGain, uint8_t aIntegralGain); // in 1/16
+    void disableFeedback();
+    int getFeedbackMicrosecondsOrUnits();                                      // Measured position
+    bool updateFeedbackCorrection(int aSetpointMicrosecondsOrUnits);
+#endif
+#if defined(ENABLE_STALL_DETECTION)
+    void setStallDetection(uint16_t (*aGetCurrentValueFunction)(uint8_t aCurrentIndex), uint8_t aCurrentIndex,
+            uint16_t aCurrentThreshold, uint8_t aNumberOfFrames, uint8_t aStallAction);
+    void setStallHandler(void (*aStallHandler)(ServoEasing*));
+    void disableStallDetection();
+    bool checkForStall();
+    void takeRequestedStallAction(); // used by updateAllServos()
+#endif
+#if defined(ENABLE_REACTIVE_SOURCE)
+    void setReactiveSource(uint16_t (*aGetSourceValueFunction)(uint8_t aSourceIndex), uint8_t aSourceIndex, uint16_t aSourceValueForStart,
+            uint16_t aSourceValueForEnd, int aStartDegreeOrMicrosecond, int aEndDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond,
+            bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+    void disableReactiveSource();
+    void updateReactiveSource();
+#endif
+#if defined(ENABLE_VELOCITY_MODE)
+    void setVelocity(int aVelocity, uint_fast16_t aVelocityChangePerSecond, bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+    void setVelocityEncoder(volatile int16_t *aEncoderTickCounterPointer, uint16_t aTicksPerRevolution);
+    void setVelocityRPM(int aRPM, uint_fast16_t aRPMChangePerSecond, bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+    int getMeasuredRPM();
+    void disableVelocityMode();
+    void updateVelocity(uint32_t aNow);
+    void startVelocityMode(bool aStartUpdateByInterrupt);
+#endif
+#if defined(ENABLE_LATENCY_MEASUREMENT)
+    void startLatencyMeasurement();
+    void recordLatencyOfWrite();
+#endif
+#if defined(ENABLE_CALIBRATION_TABLE)
+    void setCalibrationTable(const int8_t *aCorrectionsMicrosecondsOrUnits, uint8_t aNumberOfPoints); // 0 points -> no correction
+    int getCalibrationCorrection(int aMicrosecondsOrUnits);
+#  if defined(CALIBRATION_TABLE_EEPROM_ADDRESS)
+    void eepromReadCalibrationTable();
+    void eepromWriteCalibrationTable();
+#  endif
+#endif
+#if defined(ENABLE_IDLE_POWER_DOWN)
+    void setIdleTimeout(uint16_t aIdleTimeoutMillis);                           // 0 -> output is never switched off
+    void powerDownOutput();
+    void rearmOutput();
+    bool isOutputPoweredDown();
+#endif
+#if defined(ENABLE_UPDATE_PRIORITY_ORDER)
+    void setUpdatePriority(uint8_t aUpdatePriority);                           // Higher values are updated first, default is 0
+    uint8_t getUpdatePriority();
+#endif
 
     void stop();
     void pause();
     void resumeWithInterrupts();
     void resumeWithoutInterrupts();
     bool update();
+    bool update(uint32_t aNow); // aNow is the value of getServoEasingTime() at start of the frame
+    static uint32_t getMillisSinceStart(uint32_t aNow, ServoEasingTimeType aMillisAtStartMove);
+#if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+    int computeMicrosecondsOrUnits(uint32_t aMillisSinceStart);
+#endif
+#if defined(ENABLE_TRAJECTORY_BUFFER)
+    bool fillTrajectoryBuffer();
+    bool getTrajectoryBufferMicrosecondsOrUnits(uint32_t aMillisSinceStart, int *aMicrosecondsOrUnits);
+#endif
+#if defined(ENABLE_PACKED_UPDATE_KERNEL)
+    void updatePackedKernelEntry();
+#  if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL)
+    static void computePackedKernelPositions(uint32_t aNow); // used in updateAllServos()
+#  endif
+#endif
+#if defined(ENABLE_ACTIVE_SERVO_LIST)
+    void addToActiveServoList();
+    void removeFromActiveServoList();
+#endif
 
+#if !defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
     void setTargetPositionReachedHandler(void (*aTargetPositionReachedHandler)(ServoEasing*));
+#endif
 
     int getCurrentAngle();
     int getEndMicrosecondsOrUnits();
@@ -525,9 +2006,16 @@ public:
 
     int MicrosecondsOrUnitsToDegree(int aMicrosecondsOrUnits);
     int MicrosecondsToDegree(int aMicroseconds);
+#if defined(USE_PRECOMPUTED_SCALE_FACTORS)
+    void setScaleFactors(); // used in attach()
+    int scaleDegreeToMicrosecondsOrUnits(int aDegree);
+#endif
     int MicrosecondsOrUnitsToMicroseconds(int aMicrosecondsOrUnits);
     int DegreeOrMicrosecondToMicrosecondsOrUnits(int aDegreeOrMicrosecond);
     int DegreeOrMicrosecondToMicrosecondsOrUnits(float aDegreeOrMicrosecond);
+#if defined(USE_FIXED_POINT_MOVE_SETUP)
+    int SixteenthDegreeToMicrosecondsOrUnits(int32_t aSixteenthDegree);
+#endif
 //    int DegreeToMicrosecondsOrUnits(float aDegree);
     int DegreeToMicrosecondsOrUnitsWithTrimAndReverse(int aDegree);
 
@@ -581,23 +2069,148 @@ public:
      * max speed is 450 degree/sec for SG90 and 540 degree/second for MG90 servos -> see speedTest.cpp
      */
     uint_fast16_t mSpeed; ///< in DegreesPerSecond - only set by setSpeed(int16_t aSpeed);
+#if defined(ENABLE_WRITE_DEADBAND)
+    uint8_t mWriteDeadbandMicrosecondsOrUnits; ///< Only set by setWriteDeadband()
+#endif
+#if defined(ENABLE_SERVO_FEEDBACK)
+    uint16_t (*mGetFeedbackValueFunction)(uint8_t aFeedbackIndex); ///< NULL -> no feedback. Must not block, since it is called by update().
+    uint8_t mFeedbackIndex;             ///< Parameter for mGetFeedbackValueFunction, e.g. the index of the ADC background channel
+    uint8_t mFeedbackProportionalGain;  ///< in 1/16
+    uint8_t mFeedbackIntegralGain;      ///< in 1/16
+    uint16_t mFeedbackValueFor0Degree;
+    uint16_t mFeedbackValueFor180Degree;
+    int mFeedbackIntegral;              ///< Sum of errors, limited to avoid windup
+    int mFeedbackCorrectionMicrosecondsOrUnits; ///< Added to the value written by _writeMicrosecondsOrUnits()
+#endif
+#if defined(ENABLE_STALL_DETECTION)
+    uint16_t (*mGetCurrentValueFunction)(uint8_t aCurrentIndex); ///< NULL -> no stall detection. Must not block, since it is called by update().
+    uint8_t mCurrentIndex;              ///< Parameter for mGetCurrentValueFunction, e.g. the index of the ADC background channel
+    uint8_t mStallNumberOfFrames;       ///< Number of consecutive frames with current above threshold to detect a stall
+    uint8_t mStallFrameCounter;
+    uint8_t mStallAction;               ///< STALL_ACTION_STOP, STALL_ACTION_PAUSE or STALL_ACTION_DETACH
+    volatile bool mStallActionIsRequested; ///< Set by update() at a stall, reset by takeRequestedStallAction(). Never a packed flag.
+    uint16_t mStallCurrentThreshold;
+    void (*StallHandler)(ServoEasing*); ///< Is called after the stall action
+#endif
+#if defined(ENABLE_REACTIVE_SOURCE)
+    uint16_t (*mGetReactiveSourceValueFunction)(uint8_t aSourceIndex); ///< NULL -> not bound. Must not block, since it is called by update().
+    uint8_t mReactiveSourceIndex;       ///< Parameter for mGetReactiveSourceValueFunction
+    uint16_t mReactiveSourceValueForStart;
+    uint16_t mReactiveSourceValueForEnd;
+    int mReactiveStartMicrosecondsOrUnits;
+    int mReactiveDeltaMicrosecondsOrUnits;
+    uint16_t mReactiveMaxStepMicrosecondsOrUnits; ///< Speed limit per frame, 0 -> no limit
+#endif
+#if defined(ENABLE_VELOCITY_MODE)
+    bool mVelocityModeIsActive;
+    bool mVelocityIsClosedLoop;         ///< Set by setVelocityRPM(), reset by setVelocity()
+    int32_t mVelocityTargetQ8;          ///< Microseconds or units, or RPM for closed loop, times 256
+    int32_t mVelocityCurrentQ8;         ///< Ramped value of mVelocityTargetQ8
+    uint16_t mVelocityStepQ8;           ///< Maximum change of mVelocityCurrentQ8 per frame, 0 -> no ramp
+    volatile int16_t *mEncoderTickCounterPointer; ///< NULL -> open loop
+    uint16_t mEncoderTicksPerRevolution;
+    int16_t mEncoderTicksAtLastMeasurement;
+    uint32_t mMillisAtLastEncoderMeasurement;
+    int32_t mVelocityOutputQ8;          ///< Output of the integral controller in microseconds or units times 256
+    int16_t mMeasuredRPM;
+#endif
+#if defined(ENABLE_LATENCY_MEASUREMENT)
+    uint32_t mMicrosAtCommand;
+    volatile uint8_t mLatencyState;     ///< LATENCY_STATE_IDLE, LATENCY_STATE_COMMANDED or LATENCY_STATE_STAGED
+#endif
+#if defined(ENABLE_CALIBRATION_TABLE)
+    uint8_t mCalibrationNumberOfPoints; ///< 0 -> no correction
+    int8_t mCalibrationTable[CALIBRATION_TABLE_MAX_POINTS];
+#endif
+#if defined(ENABLE_IDLE_POWER_DOWN)
+    uint16_t mIdleTimeoutMillis;        ///< 0 -> disabled
+    bool mOutputIsPoweredDown;
+    uint32_t mMillisAtStartOfIdle;      ///< Set by checkForIdleServos(), reset to 0 by each write
+#endif
+#if defined(ENABLE_UPDATE_PRIORITY_ORDER)
+    uint8_t mUpdatePriority;            ///< Higher values are updated first by updateAllServos()
+#endif
 
 #if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
     uint8_t mEasingType; // EASE_LINEAR, EASE_QUADRATIC_IN_OUT, EASE_CUBIC_IN_OUT, EASE_QUARTIC_IN_OUT
+#  if defined(ENABLE_RETARGET)
+    int mRetargetSpeedDelta; ///< Start speed * duration of a retarget() move in microseconds or units. 0 -> no Hermite segment, use mEasingType.
+    int mRetargetPendingTargetDegreeOrMicrosecond; ///< Target of the move after the brake segment of retarget()
+    uint16_t mRetargetPendingDegreesPerSecond; ///< Speed of the move after the brake segment of retarget(). 0 -> no pending move.
+#  endif
+#  if defined(ENABLE_SPLINE_PATH)
+    const int *mSplineWaypoints; ///< NULL -> no spline path, use mEasingType
+    uint8_t mSplineNumberOfWaypoints;
+    uint8_t mSplineSegmentIndex; ///< 0 is the segment from mSplineStartMicrosecondsOrUnits to mSplineWaypoints[0]
+    uint16_t mSplineMillisPerSegment;
+    int mSplineStartMicrosecondsOrUnits; ///< Position at start of path
+    int mSplineCoefficients[3]; ///< Coefficients of u, u^2 and u^3 of the current segment in microseconds or units
+#  endif
 #  if defined(ENABLE_EASE_USER)
     void *UserDataPointer;
     float (*mUserEaseInFunction)(float aPercentageOfCompletion, void *aUserDataPointer);
 #  endif
+#  if defined(ENABLE_EASE_TABLE)
+    const int16_t *mEaseTablePGM; ///< Breakpoint pairs of time and position in per mille in PROGMEM
+    uint8_t mEaseTableSegmentIndex; ///< Index of the first breakpoint of the segment used for the last evaluation
+#  endif
+#  if defined(ENABLE_EASING_TEMPLATES)
+    float (*mFactorOfMovementCompletionFunction)(float aFactorOfTimeCompletion); ///< Set by setEasingType<EASE_...>(), NULL for runtime selection
+#  endif
+#  if defined(ENABLE_FORWARD_DIFFERENCING)
+    int64_t mForwardDifferences[FORWARD_DIFFERENCING_MAX_DEGREE + 1]; ///< Position and its forward differences scaled by 2^32
+    uint32_t mMillisSinceStartOfNextForwardDifference; ///< The expected tMillisSinceStart of the next regular update() call
+    uint8_t mFramesUntilForwardDifferencingResync; ///< 0 forces computing of mForwardDifferences at next update()
+    bool mForwardDifferencingIsSecondHalf; ///< For IN_OUT and BOUNCING, the second half is another polynomial
+#  endif
+#  if defined(ENABLE_EASE_TRAPEZOIDAL)
+    uint16_t mMaxAcceleration; ///< In degrees per second squared, only used for EASE_TRAPEZOIDAL
+    uint16_t mTrapezoidalAccelerationFraction; ///< Duration of acceleration / duration of move in Q15 format, 0 to FIXED_POINT_HALF
+#  endif
+#  if defined(ENABLE_EASE_S_CURVE)
+    uint16_t mMaxJerk; ///< In degrees per second cubed, only used for EASE_S_CURVE
+    ServoEasingSCurveSegmentsStruct mSCurveSegments; ///< The first half of the S-curve, set by setSCurveSegments()
+#  endif
+#  if defined(ENABLE_TRAJECTORY_BUFFER)
+    /*
+     * mTrajectoryBuffer[] contains the frame positions from mTrajectoryFirstFrame to mTrajectoryFramesFilled - 1,
+     * if mTrajectoryFilledSequence is equal to mTrajectorySequence.
+     * All values but mTrajectorySequence are only written by fillTrajectoryBuffer() with interrupts disabled.
+     */
+    int16_t mTrajectoryBuffer[TRAJECTORY_BUFFER_SIZE]; ///< Position for frame n at index n & (TRAJECTORY_BUFFER_SIZE - 1)
+    uint16_t mTrajectoryFirstFrame;
+    uint16_t mTrajectoryFramesFilled;
+    uint8_t mTrajectoryFilledSequence;
+    volatile uint8_t mTrajectorySequence; ///< Incremented at each change of the values of a move, invalidates the buffer.
+#  endif
 #endif
 
-    volatile bool mServoMoves;
+    volatile bool mServoMoves; // Never a bit of the packed flags below, since it is written by interrupt
+
+#if defined(ENABLE_COMPACT_SERVO_LAYOUT)
+    /*
+     * Packed flags, see the descriptions of the not packed flags below
+     */
+    bool mOperateServoReverse :1;
+#  if !defined(DISABLE_PAUSE_RESUME) && !defined(ENABLE_STALL_DETECTION) // A stall pauses the servo by interrupt
+    bool mServoIsPaused :1;
+#  endif
+#  if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_SERVO_LIB)
+    bool mServoIsConnectedToExpander :1;
+#  endif
+#endif
 
 #if defined(USE_PCA9685_SERVO_EXPANDER)
-#  if defined(USE_SERVO_LIB)
+#  if defined(USE_SERVO_LIB) && !defined(ENABLE_COMPACT_SERVO_LAYOUT)
     // Here we can have both types of servo connections
     bool mServoIsConnectedToExpander; // to distinguish between different using microseconds or PWM units and appropriate write functions
 #  endif
     uint8_t mPCA9685I2CAddress;
+    uint8_t mPCA9685ExpanderIndex; ///< Index in sPCA9685Expanders[] or INVALID_SERVO if no entry was available at attach()
+#  if defined(ENABLE_PCA9685_WRITE_BUDGET)
+    uint8_t mWritePriority; ///< SERVO_WRITE_PRIORITY_LOW or SERVO_WRITE_PRIORITY_HIGH
+    bool mWriteWasDeferred; ///< true if the last write was deferred. Then a part of the budget of the next frames is reserved for this servo.
+#  endif
 #  if !defined(USE_SOFT_I2C_MASTER)
     TwoWire *mI2CClass;
 #  endif
@@ -605,12 +2218,32 @@ public:
     uint8_t mServoPin; ///< pin number / port number of PCA9685 [0-15] or NO_SERVO_ATTACHED_PIN_NUMBER - at least required for Lightweight Servo Library
 
     uint8_t mServoIndex; ///< Index in sServoArray or INVALID_SERVO if error while attach() or if detached
+#if defined(ENABLE_ACTIVE_SERVO_LIST)
+    uint8_t mActiveServoListIndex; ///< Index in sActiveServos or INVALID_SERVO if not moving
+#endif
+#if defined(ENABLE_DENSE_SERVO_REGISTRY)
+    uint8_t mAttachedServoListIndex; ///< Index in sAttachedServos or INVALID_SERVO if not attached
+#endif
+#if defined(ENABLE_MOTION_QUEUE)
+    ServoEasingMoveStruct mMotionQueue[MOTION_QUEUE_SIZE];
+    volatile uint8_t mMotionQueueWriteIndex; ///< Only written by queueMove(). Index of next free entry.
+    volatile uint8_t mMotionQueueReadIndex; ///< Only written by update(). Index of next move. Queue is empty if equal to mMotionQueueWriteIndex.
+    volatile uint8_t mMotionQueueClearIndex; ///< Written by clearMotionQueue(). The moves before this index are discarded by update().
+    volatile bool mMotionQueueClearIsRequested; ///< Set by clearMotionQueue(), reset by update() after setting mMotionQueueReadIndex.
+#endif
+#if defined(ENABLE_SERVO_MAILBOX)
+    volatile ServoEasingMoveStruct mMailboxMove;
+    volatile uint8_t mMailboxSequence; ///< Only written by postMove(). Odd while mMailboxMove is written.
+    volatile uint8_t mMailboxStartedSequence; ///< Written by startPostedMove() and stop(). A move is posted if not equal to mMailboxSequence.
+#endif
 
-    uint32_t mMillisAtStartMove;
-    uint_fast16_t mMillisForCompleteMove;
+    ServoEasingTimeType mMillisAtStartMove; // In microseconds for ENABLE_MICROS_TIME_BASE, lower 16 bit for ENABLE_COMPACT_SERVO_LAYOUT
+    ServoEasingDurationType mMillisForCompleteMove; // In microseconds for ENABLE_MICROS_TIME_BASE
 #if !defined(DISABLE_PAUSE_RESUME)
+#  if !defined(ENABLE_COMPACT_SERVO_LAYOUT) || defined(ENABLE_STALL_DETECTION)
     bool mServoIsPaused;
-    uint32_t mMillisAtStopMove;
+#  endif
+    ServoEasingTimeType mMillisAtStopMove;
 #endif
 
     /**
@@ -618,7 +2251,9 @@ public:
      * Be careful, if you specify different end values, it may not behave, as you expect.
      * For this case better use the attach function with 5 parameter.
      */
+#if !defined(ENABLE_COMPACT_SERVO_LAYOUT)
     bool mOperateServoReverse; ///< true -> direction is reversed
+#endif
 #if !defined(DISABLE_MIN_AND_MAX_CONSTRAINTS)
     int mMaxMicrosecondsOrUnits; ///< Max value checked at _writeMicrosecondsOrUnits(), before trim and reverse is applied
     int mMinMicrosecondsOrUnits; ///< Min value checked at _writeMicrosecondsOrUnits(), before trim and reverse is applied
@@ -631,8 +2266,14 @@ public:
      */
     int mServo0DegreeMicrosecondsOrUnits;
     int mServo180DegreeMicrosecondsOrUnits;
+#if defined(USE_PRECOMPUTED_SCALE_FACTORS)
+    uint32_t mDegreeToMicrosecondsOrUnitsFactor; ///< (180 degree value - 0 degree value) / 180 in Q16 format, rounded up
+    int32_t mMicrosecondsOrUnitsToDegreeFactor; ///< 180 / (180 degree value - 0 degree value) in Q16 format, negative for reverse attach()
+#endif
 
+#if !defined(DISABLE_TARGET_POSITION_REACHED_HANDLER)
     void (*TargetPositionReachedHandler)(ServoEasing*);  ///< Is called any time when target servo position is reached
+#endif
 
     /**
      * It is required for ESP32, where the timer interrupt routine does not block the loop. Maybe it runs on another CPU?
@@ -649,7 +2290,143 @@ public:
      */
     static uint_fast8_t sServoArrayMaxIndex; ///< maximum index of an attached servo in sServoArray[]
     static ServoEasing *ServoEasingArray[MAX_EASING_SERVOS];
-    static float ServoEasingNextPositionArray[MAX_EASING_SERVOS];
+    static ServoEasingPositionType ServoEasingNextPositionArray[MAX_EASING_SERVOS]; ///< int16_t for ENABLE_COMPACT_SERVO_LAYOUT
+#if defined(ENABLE_SERVO_MAILBOX)
+    static volatile bool sMoveIsPosted; ///< Set by postMove(), reset by updateAllServos() before checking all mailboxes
+#endif
+#if defined(ENABLE_ACTIVE_SERVO_LIST)
+    static ServoEasing *sActiveServos[MAX_EASING_SERVOS]; ///< The moving servos in no particular order
+    static uint_fast8_t sNumberOfActiveServos;
+#endif
+#if defined(ENABLE_DENSE_SERVO_REGISTRY)
+    static ServoEasing *sAttachedServos[MAX_EASING_SERVOS]; ///< The attached servos without holes in no particular order
+    static uint_fast8_t sNumberOfAttachedServos;
+#endif
+#if defined(ENABLE_UPDATE_PRIORITY_ORDER)
+    static uint8_t sServoUpdateOrder[2][MAX_EASING_SERVOS]; ///< Indexes of all attached servos, highest update priority first
+    static uint8_t sNumberOfServosInUpdateOrder[2];
+    static volatile uint8_t sServoUpdateOrderBufferIndex; ///< Buffer used by updateAllServos(), the other one is written by sortServoUpdateOrder()
+    static volatile bool sServoUpdateOrderIsInUse; ///< true while updateAllServos() iterates the buffer of sServoUpdateOrderBufferIndex
+    static volatile bool sServoUpdateOrderSwapIsPending; ///< Set by sortServoUpdateOrder() during updateAllServos(), which then swaps the buffers
+#endif
+#if defined(ENABLE_EXTERNAL_FRAME_BUFFER)
+    static int16_t sExternalFrameBuffers[2][MAX_EASING_SERVOS]; ///< Microseconds or units, index is the servo index
+    static volatile uint8_t sExternalFrameBufferWriteIndex; ///< Buffer returned by getExternalFrameBuffer(), the other one is committed
+    static volatile bool sExternalFrameIsCommitted; ///< true until the committed buffer is written by updateAllServos()
+#endif
+#if defined(ENABLE_PACKED_UPDATE_KERNEL)
+    /*
+     * Copies of the values of all moving linear servos, indexed by mServoIndex. Only written by updatePackedKernelEntry().
+     */
+    static bool sPackedIsActive[MAX_EASING_SERVOS]; ///< true if the servo is moving linear and not paused and updated by the packed kernel
+    static int16_t sPackedStartMicrosecondsOrUnits[PACKED_KERNEL_ARRAY_SIZE];
+    static int16_t sPackedDeltaMicrosecondsOrUnits[PACKED_KERNEL_ARRAY_SIZE];
+    static int16_t sPackedCurrentMicrosecondsOrUnits[MAX_EASING_SERVOS];
+    static uint16_t sPackedMillisForCompleteMove[MAX_EASING_SERVOS];
+    static ServoEasingTimeType sPackedMillisAtStartMove[MAX_EASING_SERVOS];
+#  if defined(ENABLE_SIMD_PACKED_UPDATE_KERNEL)
+    static int16_t sPackedFractionOfTimeCompletion[PACKED_KERNEL_ARRAY_SIZE]; ///< Q15, computed by computePackedKernelPositions(), PACKED_FRACTION_INVALID after a change of the move
+    static int16_t sPackedNewMicrosecondsOrUnits[PACKED_KERNEL_ARRAY_SIZE]; ///< Computed by computePackedKernelPositions()
+#  endif
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER)
+    static PCA9685ExpanderStruct sPCA9685Expanders[MAX_PCA9685_EXPANDERS];
+    static uint_fast8_t sNumberOfPCA9685Expanders;
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(ENABLE_PCA9685_WRITE_BUDGET)
+    static uint16_t sPCA9685WriteBudgetBytes; ///< Initialized with PCA9685_WRITE_BUDGET_BYTES, can be changed at runtime
+    static int16_t sPCA9685WriteBudgetBytesLeft; ///< Can be negative, since high priority writes are always done
+    static int16_t sPCA9685ReservedBytes; ///< Bytes reserved for the deferred servos at and above sPCA9685RoundRobinStartIndex
+    static uint8_t sPCA9685RoundRobinStartIndex; ///< Low priority servos at and above this index are served first
+    static uint8_t sPCA9685FirstDeferredOffset; ///< Offset of the first deferred servo from sPCA9685RoundRobinStartIndex
+    static uint8_t sNumberOfDeferredPCA9685WritesInFrame;
+    static bool sPCA9685WriteBudgetIsActive; ///< true while updateAllServos() is running
+    static uint32_t sNumberOfDeferredPCA9685Writes;
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(ENABLE_SOFT_I2C_INTERRUPT_TRANSFER)
+    static volatile uint8_t sI2CTransferQueue[I2C_TRANSFER_QUEUE_SIZE];
+    static volatile uint8_t sI2CTransferQueueWriteIndex; ///< Only changed by enqueueI2CTransfer()
+    static volatile uint8_t sI2CTransferQueueReadIndex; ///< Only changed by the TWI interrupt
+    static volatile uint8_t sI2CTransferNumberOfBytesLeft; ///< Bytes of the current transmission not yet sent
+    static volatile bool sI2CTransferIsActive; ///< true from start of the first transmission until the queue is empty
+    static volatile uint16_t sI2CTransferNumberOfErrors; ///< Transmissions not acknowledged by the board
+    static uint16_t sI2CTransferNumberOfWaitsForQueue; ///< Number of enqueueI2CTransfer() calls waiting for free space in the queue
+    static uint16_t sI2CTransferNumberOfDroppedTransfers; ///< Number of transmissions, which did not fit into the queue while interrupts were disabled
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(ENABLE_PCA9685_FRAME_COMMIT)
+    static volatile bool sStageValuesInFrameBuffer; ///< true while updateAllServos() is running. Then setPWM() does only stage the values.
+#  if defined(ENABLE_PCA9685_SYNCHRONOUS_COMMIT)
+    static bool sPCA9685HoldBusUntilCommit; ///< true while flushPCA9685FrameBuffers() is running. Then transmissions end without stop.
+    static bool sPCA9685CommitIsPending; ///< A transmission without stop was sent, so the bus is still held
+#  endif
+#  if defined(ENABLE_PCA9685_DEFERRED_TRANSFER)
+    static volatile uint16_t sPCA9685NumberOfStagedFrames; ///< Incremented by updateAllServos() if values were staged
+    static uint16_t sPCA9685NumberOfTransferredFrames; ///< Set to sPCA9685NumberOfStagedFrames by transferStagedPCA9685Frames()
+#  endif
+#  if defined(ENABLE_PCA9685_RESET_RECOVERY)
+    static uint8_t sPCA9685NextExpanderToCheck; ///< Index of the board checked by the next checkPCA9685ExpandersForReset()
+    static uint16_t sNumberOfPCA9685Recoveries;
+#  endif
+#endif
+#if defined(ENABLE_UPDATE_STATISTICS)
+    static ServoEasingUpdateStatisticsStruct sUpdateStatistics;
+#endif
+#if defined(ENABLE_TELEMETRY_BUFFER)
+    static ServoEasingTelemetryRecordStruct sTelemetryBuffer[TELEMETRY_BUFFER_SIZE];
+    static volatile uint8_t sTelemetryWriteIndex; ///< Only changed by updateAllServos()
+    static volatile uint8_t sTelemetryReadIndex; ///< Only changed by writeTelemetryRecords()
+    static uint16_t sTelemetryFrameNumber;
+    static bool sTelemetryFrameIsActive; ///< true while updateAllServos() is running. Then writes are recorded.
+    static bool sTelemetryRecordsLost;
+    static uint16_t sTelemetryNumberOfLostRecords;
+#endif
+#if defined(ENABLE_TRACE_POINTS)
+    static ServoEasingTraceEntryStruct sTraceBuffer[TRACE_BUFFER_SIZE];
+    static volatile uint8_t sTraceIndex; ///< Index of the next entry to record. Recording stops at TRACE_BUFFER_SIZE.
+    static bool sTraceFrameIsActive; ///< true while updateAllServos() is running. Then trace points are recorded.
+#endif
+#if defined(ENABLE_LATENCY_MEASUREMENT)
+    static ServoEasingLatencyHistogramStruct sLatencyHistograms[LATENCY_NUMBER_OF_BACKENDS];
+    static bool sLatencyValueIsStaged; ///< At least one servo has mLatencyState == LATENCY_STATE_STAGED
+#endif
+#if defined(ENABLE_FRAME_COUNTER_TIME_BASE) || defined(ENABLE_TIME_SCALE)
+    static volatile uint32_t sFrameTime; ///< Advanced by updateAllServos() by SERVO_EASING_TIME_UNITS_PER_REFRESH or the scaled real time
+#endif
+#if defined(ENABLE_TIME_SCALE) || defined(ENABLE_FRAME_WATCHDOG)
+    static uint32_t sRealTimeAtLastFrame; ///< getServoEasingRealTime() at the last updateAllServos()
+    static uint16_t sNumberOfLateFrames;
+#endif
+#if defined(ENABLE_TIME_SCALE)
+    static uint16_t sTimeScalePercent;
+    static uint8_t sTimeScaleRemainder; ///< Remainder of the division by 100 of the last frame, to avoid drift
+#endif
+#if defined(ENABLE_FRAME_WATCHDOG)
+    static uint8_t sNumberOfConsecutiveLateFrames;
+    static uint16_t sNumberOfFrameWatchdogStops;
+#endif
+#if defined(ENABLE_STALL_DETECTION)
+    static bool sStallActionIsRequested; ///< At least one servo has mStallActionIsRequested set
+#endif
+#if defined(ENABLE_SIMULATION_MODE)
+    static Print *sSimulationTraceOutput;       ///< Receives one line for each servo write. NULL -> no trace.
+    static uint_fast16_t sSimulationMillisRemainder; ///< Milliseconds of runSimulation() not yet used for a refresh interval
+#endif
+#if defined(ENABLE_TIMELINE_PLAYER)
+    static const uint16_t *volatile sTimelineNextKeyframePGM; ///< Points to the next keyframe to start. NULL if no timeline is playing.
+    static uint32_t sTimelineMillisOfNextKeyframe;
+#endif
+#if defined(ENABLE_POSITION_FRAME_RECEIVER)
+    static ServoEasingPositionFrameReceiverStruct sPositionFrameReceiver;
+#endif
+#if defined(ENABLE_SERVO_EASING_TASKS)
+    static ServoEasingTask *sFirstServoEasingTask; ///< List of running tasks
+    static uint32_t sMillisOfLastTaskUpdate; ///< millis() of last updateAllServos() called by runServoEasingTasks()
+#endif
+#if defined(ENABLE_FRAME_SCHEDULER)
+    static ServoEasingFrameJob *sFirstFrameJob; ///< List of registered jobs. The servo timer runs as long as it is not empty.
+    static volatile bool sFrameTimerIsRunning; ///< true between enableServoEasingInterrupt() and the disableServoEasingInterrupt() without jobs
+    static ServoEasingFrameSchedulerStatisticsStruct sFrameSchedulerStatistics;
+#endif
     /*
      * Macros for backward compatibility
      */
@@ -674,11 +2451,147 @@ void setDegreeForAllServos(uint_fast8_t aNumberOfValues, ...);
 bool setEaseToForAllServos();
 bool setEaseToForAllServos(uint_fast16_t aDegreesPerSecond);
 bool setEaseToDForAllServos(uint_fast16_t aMillisForMove);
+#if defined(ENABLE_EASING_TEMPLATES) && !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+/*
+ * The IN functions for the compile time easing selection.
+ * Only the specializations below are defined, so using an unsupported easing type gives a compile error.
+ */
+template<uint_fast8_t tEaseType> struct EaseInFunction;
+#  if defined(ENABLE_EASE_QUADRATIC)
+template<> struct EaseInFunction<EASE_QUADRATIC_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::QuadraticEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_CUBIC)
+template<> struct EaseInFunction<EASE_CUBIC_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::CubicEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_QUARTIC)
+template<> struct EaseInFunction<EASE_QUARTIC_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::QuarticEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_SINE)
+template<> struct EaseInFunction<EASE_SINE_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::SineEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_CIRCULAR)
+template<> struct EaseInFunction<EASE_CIRCULAR_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::CircularEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_BACK)
+template<> struct EaseInFunction<EASE_BACK_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::BackEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_ELASTIC)
+template<> struct EaseInFunction<EASE_ELASTIC_IN> {
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::ElasticEaseIn(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+#  if defined(ENABLE_EASE_BOUNCE)
+template<> struct EaseInFunction<EASE_BOUNCE_OUT> { // we have only the out function implemented
+    static float call(float aFactorOfTimeCompletion) {
+        return ServoEasing::EaseOutBounce(aFactorOfTimeCompletion);
+    }
+};
+#  endif
+
+/**
+ * Compile time version of the call style conversions in update().
+ * All conditions depend only on the template parameter and are therefore removed by the compiler.
+ */
+template<uint_fast8_t tEasingType>
+float getFactorOfMovementCompletion(float aFactorOfTimeCompletion) {
+    typedef EaseInFunction<tEasingType & EASE_TYPE_MASK> tEaseIn;
+    if ((tEasingType & CALL_STYLE_MASK) == CALL_STYLE_DIRECT) {
+        return tEaseIn::call(aFactorOfTimeCompletion);
+    } else if ((tEasingType & CALL_STYLE_MASK) == CALL_STYLE_OUT) {
+        return 1.0 - tEaseIn::call(1.0 - aFactorOfTimeCompletion);
+    } else if ((tEasingType & CALL_STYLE_MASK) == CALL_STYLE_IN_OUT) {
+        if (aFactorOfTimeCompletion <= 0.5) {
+            return 0.5 * tEaseIn::call(2.0 * aFactorOfTimeCompletion);
+        }
+        return 1.0 - (0.5 * tEaseIn::call(2.0 - (2.0 * aFactorOfTimeCompletion)));
+    } else {
+        // CALL_STYLE_BOUNCING_OUT_IN
+        if (aFactorOfTimeCompletion <= 0.5) {
+            return 1.0 - tEaseIn::call(1.0 - (2.0 * aFactorOfTimeCompletion));
+        }
+        return 1.0 - tEaseIn::call((2.0 * aFactorOfTimeCompletion) - 1.0);
+    }
+}
+
+template<uint_fast8_t tEasingType>
+void ServoEasing::setEasingType() {
+    mEasingType = tEasingType;
+    mFactorOfMovementCompletionFunction = &getFactorOfMovementCompletion<tEasingType>;
+}
+
+/**
+ * A servo with an easing type selected at compile time, e.g. ServoEasingT<EASE_CUBIC_IN_OUT> Servo1;
+ * update() is not virtual, so the servo is still updated by the function pointer set by setEasingType<tEasingType>().
+ * It can be used everywhere a ServoEasing can be used. Calling setEasingType(aEasingType) switches back to runtime selection.
+ */
+template<uint_fast8_t tEasingType>
+class ServoEasingT: public ServoEasing {
+public:
+#  if defined(USE_PCA9685_SERVO_EXPANDER)
+#    if defined(USE_SOFT_I2C_MASTER)
+    ServoEasingT(uint8_t aPCA9685I2CAddress) :
+            ServoEasing(aPCA9685I2CAddress) {
+        setEasingType<tEasingType>();
+    }
+#    else
+#      if defined(ARDUINO_SAM_DUE)
+    ServoEasingT(uint8_t aPCA9685I2CAddress, TwoWire *aI2CClass = &Wire1) :
+#      else
+    ServoEasingT(uint8_t aPCA9685I2CAddress, TwoWire *aI2CClass = &Wire) :
+#      endif
+            ServoEasing(aPCA9685I2CAddress, aI2CClass) {
+        setEasingType<tEasingType>();
+    }
+#    endif
+#  endif
+    ServoEasingT() :
+            ServoEasing() {
+        setEasingType<tEasingType>();
+    }
+};
+#endif // defined(ENABLE_EASING_TEMPLATES) && !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+
 void setEaseToForAllServosSynchronizeAndStartInterrupt();
 void setEaseToForAllServosSynchronizeAndStartInterrupt(uint_fast16_t aDegreesPerSecond);
 void synchronizeAndEaseToArrayPositions();
 void synchronizeAndEaseToArrayPositions(uint_fast16_t aDegreesPerSecond);
 void synchronizeAllServosAndStartInterrupt(bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+#if defined(ENABLE_EXTERNAL_FRAME_BUFFER)
+int16_t* getExternalFrameBuffer();
+bool commitExternalFrameBuffer(); // Returns false if the last committed buffer is not yet written
+bool isExternalFrameCommitted();
+void writeCommittedExternalFrame(); // used by updateAllServos()
+#endif
+#if defined(ENABLE_BATCHED_MOVE_SETUP)
+bool setEaseToArrayPositionsSynchronizeAndStartInterrupt(const ServoEasingPositionType aTargetPositions[], uint_fast16_t aDegreesPerSecond,
+        bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT); // Index of aTargetPositions[] is the servo index
+#endif
 
 #if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
 void setEasingTypeForAllServos(uint_fast8_t aEasingType);
@@ -696,6 +2609,146 @@ void stopAllServos();
 void resumeWithInterruptsAllServos();
 void resumeWithoutInterruptsAllServos();
 bool updateAllServos();
+#if defined(ENABLE_UPDATE_STATISTICS)
+void resetUpdateStatistics();
+uint16_t getAverageUpdateMicros();
+void printUpdateStatistics(Print *aSerial);
+#endif
+#if defined(ENABLE_TELEMETRY_BUFFER)
+uint8_t writeTelemetryRecords(Print *aSerial);
+uint16_t getNumberOfLostTelemetryRecords();
+#endif
+#if defined(ENABLE_TRACE_POINTS)
+void startTrace();
+bool isTraceComplete();
+void recordTracePoint(uint8_t aTracePoint, uint8_t aServoIndex);
+void printTrace(Print *aSerial);
+void printChromeTrace(Print *aSerial);
+#endif
+#if defined(ENABLE_LATENCY_MEASUREMENT)
+void recordLatency(uint_fast8_t aBackend, uint32_t aLatencyMicros);
+void recordStagedLatencies();
+void resetLatencyHistograms();
+void printLatencyHistograms(Print *aSerial);
+#endif
+#if defined(ENABLE_FRAME_COUNTER_TIME_BASE) || defined(ENABLE_TIME_SCALE)
+uint32_t getServoEasingFrameTime();
+#endif
+#if defined(ENABLE_TIME_SCALE)
+void setTimeScalePercent(uint16_t aTimeScalePercent); // 100 -> real time, 50 -> slow motion, 0 -> all moves are frozen
+uint16_t getTimeScalePercent();
+#endif
+#if defined(ENABLE_TIME_SCALE) || defined(ENABLE_FRAME_WATCHDOG)
+uint16_t getNumberOfLateFrames();
+#endif
+#if defined(ENABLE_FRAME_WATCHDOG)
+uint16_t getNumberOfFrameWatchdogStops();
+#endif
+#if defined(ENABLE_SIMULATION_MODE)
+void setSimulationTraceOutput(Print *aTraceOutput);
+void runSimulation(uint32_t aMillis);
+#endif
+#if defined(ENABLE_TRAJECTORY_BUFFER)
+bool fillTrajectoryBuffers();
+#endif
+#if defined(ENABLE_TIMELINE_PLAYER)
+void startTimeline(const uint16_t *aTimelinePGM, bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+void stopTimeline();
+bool isTimelinePlaying();
+bool updateTimeline(uint32_t aNow);
+#endif
+#if defined(ENABLE_POSITION_FRAME_RECEIVER)
+bool receivePositionFrameByte(uint8_t aByte);
+bool startReceivedPositionFrame();
+uint8_t receivePositionFrames(Stream *aSerial);
+#endif
+#if defined(ENABLE_IDLE_POWER_DOWN)
+void checkForIdleServos();
+#endif
+#if defined(ENABLE_UPDATE_PRIORITY_ORDER)
+void sortServoUpdateOrder();
+#endif
+#if defined(ENABLE_SERVO_EASING_TASKS)
+void startServoEasingTask(ServoEasingTask *aTask, bool (*aTaskFunction)(ServoEasingTask *aTask));
+void stopServoEasingTask(ServoEasingTask *aTask);
+bool isServoEasingTaskRunning(ServoEasingTask *aTask);
+bool runServoEasingTasks();
+#endif
+#if defined(ENABLE_FRAME_SCHEDULER)
+void addFrameJob(ServoEasingFrameJob *aJob, void (*aJobFunction)(), uint8_t aPeriodFrames, uint8_t aOffsetFrames, uint8_t aSlot);
+void removeFrameJob(ServoEasingFrameJob *aJob);
+void resetFrameSchedulerStatistics();
+void printFrameSchedulerStatistics(Print *aSerial);
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(ENABLE_PCA9685_FRAME_COMMIT)
+void flushPCA9685FrameBuffer(uint_fast8_t aExpanderIndex);
+void flushPCA9685FrameBuffers();
+#  if defined(ENABLE_PCA9685_DEFERRED_TRANSFER)
+bool transferStagedPCA9685Frames();
+bool isPCA9685FrameTransferPending();
+#  endif
+#  if defined(ENABLE_PCA9685_RESET_RECOVERY)
+bool checkPCA9685ExpandersForReset();
+void recoverPCA9685Expander(PCA9685ExpanderStruct *aExpander);
+uint16_t getNumberOfPCA9685Recoveries();
+#  endif
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER)
+void switchOffAllPCA9685Expanders();
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(ENABLE_SOFT_I2C_INTERRUPT_TRANSFER)
+bool enqueueI2CTransfer(uint8_t aI2CAddress, uint8_t aRegister, uint8_t *aData, uint_fast8_t aNumberOfDataBytes);
+bool isI2CTransferActive();
+void waitForI2CTransferDone();
+#endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(ENABLE_PCA9685_WRITE_BUDGET)
+void startPCA9685WriteBudgetFrame();
+uint32_t getNumberOfDeferredPCA9685Writes();
+uint8_t getNumberOfDeferredPCA9685WritesInLastFrame();
+void resetNumberOfDeferredPCA9685Writes();
+#endif
+#if defined(ENABLE_ESP32_SERVO_TASK) || defined(ENABLE_RP2040_CORE1_SERVO_ENGINE)
+bool sendEaseToCommand(ServoEasing *aServo, int aTargetDegreeOrMicrosecond, uint_fast16_t aDegreesPerSecond);
+bool sendEaseToDCommand(ServoEasing *aServo, int aTargetDegreeOrMicrosecond, uint_fast16_t aMillisForMove);
+#endif
+
+#if defined(ENABLE_SERVO_EASING_GROUPS)
+/*
+ * A subset of servos, which are synchronized independently from all other servos.
+ */
+class ServoEasingGroup {
+public:
+    ServoEasingGroup();
+    uint_fast8_t addServo(ServoEasing &aServo); // Returns the index in the group or INVALID_SERVO if group is full
+    void removeAllServos();
+
+    void setSpeed(uint_fast16_t aDegreesPerSecond);
+#  if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+    void setEasingType(uint_fast8_t aEasingType);
+#  endif
+    bool setEaseTo(); // Uses the speed of each servo
+    bool setEaseTo(uint_fast16_t aDegreesPerSecond);
+    bool setEaseToD(uint_fast16_t aMillisForMove);
+    void synchronizeAndStartInterrupt(bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+    void setEaseToSynchronizeAndStartInterrupt(uint_fast16_t aDegreesPerSecond);
+    void setEaseToDSynchronizeAndStartInterrupt(uint_fast16_t aMillisForMove);
+#  if defined(ENABLE_BATCHED_MOVE_SETUP)
+    bool setEaseToPositionsSynchronizeAndStartInterrupt(const ServoEasingPositionType aTargetPositions[], uint_fast16_t aDegreesPerSecond,
+            bool aStartUpdateByInterrupt = START_UPDATE_BY_INTERRUPT);
+#  endif
+
+    bool isMoving();
+    void updateAndWaitForStop();
+    void stop();
+    void pause();
+    void resumeWithInterrupts();
+    void resumeWithoutInterrupts();
+
+    ServoEasingPositionType NextPositionArray[MAX_SERVOS_PER_GROUP]; ///< Used by setEaseTo*() like ServoEasingNextPositionArray
+    ServoEasing *ServoArray[MAX_SERVOS_PER_GROUP];
+    uint8_t NumberOfServos;
+};
+#endif
 
 void enableServoEasingInterrupt();
 #if defined(__AVR_ATmega328P__)
@@ -720,6 +2773,85 @@ bool checkI2CConnection(uint8_t aI2CAddress, Stream *aSerial); // Print class ha
 #endif
 
 /*
+ * Version 3.1.1 - work in progress
+ * - Added `ENABLE_PCA9685_FRAME_COMMIT` to send all PCA9685 channels changed by `updateAllServos()` with one I2C auto increment transmission per board.
+ * - Unchanged channels between two runs of changed PCA9685 channels are sent again, if this is cheaper than an additional transmission. Configurable by `PCA9685_TRANSMISSION_OVERHEAD_BYTES`.
+ * - Added `USE_FIXED_POINT_EASING` to compute QUADRATIC, CUBIC and QUARTIC easings with integer arithmetic.
+ * - Added `USE_EASING_LOOKUP_TABLES` to compute SINE, CIRCULAR, BACK and ELASTIC easings by table lookup.
+ * - Added `ENABLE_EASING_TEMPLATES` for easing types resolved at compile time by `setEasingType<EASE_...>()` or `ServoEasingT<EASE_...>`.
+ * - Added `ENABLE_FORWARD_DIFFERENCING` to compute QUADRATIC, CUBIC and QUARTIC easings by forward differences for regular interrupt driven updates.
+ * - Added `ENABLE_PACKED_UPDATE_KERNEL` to update all linear moving servos in one loop over packed arrays.
+ * - Added `ENABLE_ACTIVE_SERVO_LIST` to update only the moving servos.
+ * - Added `ENABLE_MOTION_QUEUE` and functions `queueEaseTo()` and `queueEaseToD()` for gapless chained moves.
+ * - Added `ENABLE_TIMELINE_PLAYER` and functions `startTimeline()`, `stopTimeline()` and `isTimelinePlaying()` to play keyframe tables stored in PROGMEM.
+ * - Added `REFRESH_INTERVAL_MICROS` to change the 20 ms servo refresh and easing interrupt period for digital servos.
+ * - Added `ENABLE_MICROS_TIME_BASE` for microsecond timing of short and fast moves.
+ * - `updateAllServos()` takes only one time stamp for all servos and calls the new `update(uint32_t aNow)`.
+ * - Added `ENABLE_FRAME_COUNTER_TIME_BASE` to use the number of updates as time base.
+ * - Added `ENABLE_UPDATE_STATISTICS` and functions `printUpdateStatistics()`, `resetUpdateStatistics()` and `getAverageUpdateMicros()` to measure the servo interrupt.
+ * - Added `ENABLE_PCA9685_DEFERRED_TRANSFER` and functions `transferStagedPCA9685Frames()` and `isPCA9685FrameTransferPending()` to move the I2C transfer out of the servo interrupt.
+ * - Added `ENABLE_ESP32_SERVO_TASK` and functions `sendEaseToCommand()` and `sendEaseToDCommand()` to update the servos of an ESP32 by a pinned FreeRTOS task.
+ * - Added `ENABLE_RP2040_CORE1_SERVO_ENGINE` to run all servo updates on core 1 of a RP2040.
+ * - Added `ENABLE_SERVO_MAILBOX` and functions `postEaseTo()`, `postEaseToD()` and `isMovePosted()` to retarget servos from loop() while the interrupt is running.
+ * - PCA9685 expanders are initialized only once per board and each I2C bus is reset only once. Configurable by `MAX_PCA9685_EXPANDERS`.
+ * - `ENABLE_PCA9685_FRAME_COMMIT` sends runs of changed channels with one transmission also for `USE_SOFT_I2C_MASTER`.
+ * - Added PCA9685 broadcast functions `writeAllChannelsOfPCA9685()`, `writeAllPCA9685Expanders()` and `switchOffAllPCA9685Expanders()` using the ALL_LED registers and the ALLCALL address.
+ * - New example ServoEasingBenchmark, which measures the CPU cycles of update(), _writeMicrosecondsOrUnits() and updateAllServos() on the target.
+ * - Fixed printEasingType() on non AVR platforms for easing types with an IN_OUT, OUT or BOUNCING flag.
+ * - Added `ENABLE_COMPACT_SERVO_LAYOUT` and `DISABLE_TARGET_POSITION_REACHED_HANDLER` to save RAM for many servos.
+ * - Added `ENABLE_TRAJECTORY_BUFFER` to sample non linear moves in advance outside of the servo interrupt.
+ * - Added `ENABLE_EASE_TRAPEZOIDAL` and `setMaxAcceleration()` for velocity and acceleration limited moves.
+ * - Added `ENABLE_EASE_S_CURVE` and `setMaxJerk()` for jerk limited moves.
+ * - Added `ENABLE_RETARGET` and function `retarget()` to change the target of a running move with continuous speed.
+ * - Added `ENABLE_SPLINE_PATH` and functions `startSplinePath()` and `setSplinePath()` for smooth moves through multiple waypoints.
+ * - Added `USE_PRECOMPUTED_SCALE_FACTORS` for conversions between degree and microseconds or units without division.
+ * - Added USE_FIXED_POINT_KINEMATICS integer CORDIC inverse kinematics to the RobotArmControl example.
+ * - Added USE_CARTESIAN_PATH_PLANNER streaming line and arc segment queue with lookahead to the RobotArmControl example.
+ * - Added USE_CLOCK_DIGIT_TIMELINES precomputed stroke tables for the clock digits of the RobotArmControl example.
+ * - Added QUADRUPED_ENABLE_GAIT_ENGINE non blocking phase based gait generator to the QuadrupedControl example.
+ * - QuadrupedControl example uses a precomputed direction and mirror table for the leg transformations.
+ * - Added `ENABLE_SERVO_EASING_TASKS` and function `runServoEasingTasks()` for cooperative tasks instead of blocking waits.
+ * - New example CooperativeTasks, which runs two independent servo sequences and a sensor read concurrently.
+ * - Added `ENABLE_SERVO_EASING_GROUPS` and class `ServoEasingGroup` for independently synchronized groups of servos.
+ * - Added `ENABLE_PCA9685_WRITE_BUDGET`, function `setWritePriority()` and `getNumberOfDeferredPCA9685Writes()` for a per frame PCA9685 I2C budget.
+ * - Added `ENABLE_WRITE_DEADBAND` and function `setWriteDeadband()` to skip intermediate writes of small changes.
+ * - `USE_LEIGHTWEIGHT_SERVO_LIB` supports all 16 bit timer channels of ATmega32U4 and ATmega1280/2560, i.e. up to 12 servos on a Mega.
+ * - `ENABLE_LIGHTWEIGHT_SERVO_STAGED_UPDATE` for glitch free LightweightServo updates synchronized to the timer period.
+ * - Added `USE_SORTED_SOFT_SERVO_LIB` and the SortedSoftServo library for up to 16 servos at arbitrary AVR pins.
+ * - Added `USE_HARDWARE_SERVO_LIB` and the HardwareServo library for pulse generation by ESP32 LEDC and RP2040 PWM hardware.
+ * - `USE_HARDWARE_SERVO_LIB` supports STM32F1 timer channels with compare registers updated together at the update event.
+ * - Added `ENABLE_ADC_BACKGROUND_SAMPLING` to ADCUtils of the examples for interrupt driven round robin sampling of feedback channels.
+ * - Added `ENABLE_SERVO_FEEDBACK` and functions `setFeedback()`, `setFeedbackGains()` for closed loop position correction of feedback servos.
+ * - Added `ENABLE_STALL_DETECTION` and functions `setStallDetection()`, `setStallHandler()` to stop, pause or detach blocked servos.
+ * - Added `ENABLE_TELEMETRY_BUFFER`, function `writeTelemetryRecords()` and host decoder extras/DecodeServoEasingTelemetry.py for binary traces without printing in the interrupt.
+ * - Added `ENABLE_POSITION_FRAME_RECEIVER`, functions `receivePositionFrames()`, `receivePositionFrameByte()`, `startReceivedPositionFrame()` and extras/SendServoEasingPositionFrames.py for binary streaming of positions.
+ * - Added ENABLE_IR_COMMAND_QUEUE to IRCommandDispatcher of the QuadrupedControl and RobotArmControl examples.
+ * - Added `ENABLE_FRAME_SCHEDULER` and functions `addFrameJob()`, `removeFrameJob()` and `printFrameSchedulerStatistics()` for periodic jobs in the servo timer interrupt.
+ * - Added `ENABLE_REACTIVE_SOURCE` and functions `setReactiveSource()` and `disableReactiveSource()` to let a servo follow a sensor value in the servo interrupt.
+ * - Added `ENABLE_IDLE_POWER_DOWN` and functions `setIdleTimeout()`, `checkForIdleServos()` and `powerDownOutput()` to switch off the output of idle servos.
+ * - Added `ENABLE_PCA9685_RESET_RECOVERY` and functions `checkPCA9685ExpandersForReset()` and `getNumberOfPCA9685Recoveries()` to restore PCA9685 boards reset by a brown out.
+ * - Added `ENABLE_PCA9685_PARALLEL_BUSES` to send the PCA9685 frames of both ESP32 I2C controllers at the same time.
+ * - Added `ENABLE_TRACE_POINTS` and functions `startTrace()`, `printTrace()` and `printChromeTrace()` to record time stamps of the update and write path of each frame.
+ * - Added `ENABLE_DENSE_SERVO_REGISTRY` for all servo functions without scanning NULL entries of `ServoEasingArray[]`.
+ * - Added `ENABLE_EASE_TABLE` and `registerEaseTable()` for piecewise linear easing curves stored in PROGMEM.
+ * - Added `ENABLE_VELOCITY_MODE` and functions `setVelocity()`, `setVelocityEncoder()` and `setVelocityRPM()` for speed ramps and closed loop RPM control of continuous rotating servos.
+ * - Added `ENABLE_CALIBRATION_TABLE` and functions `setCalibrationTable()` and `eepromWriteCalibrationTable()` for interpolated correction of nonlinear servos.
+ * - Added `ENABLE_LATENCY_MEASUREMENT` and functions `printLatencyHistograms()` and `resetLatencyHistograms()` to measure the command to hardware latency of each backend.
+ * - Added example PCA9685_StressBenchmark for 64 to 128 servos on up to 8 PCA9685 expanders.
+ * - Added `ENABLE_SIMULATION_MODE` and extras/HostSimulation to run motion sequences faster than real time and record a trace of all servo writes.
+ * - Added extras/HostSimulation/ServoEasingHostBenchmark.cpp to measure `update()` and the I2C bytes per frame for each easing type on the host.
+ * - Added `ENABLE_SOFT_I2C_INTERRUPT_TRANSFER` to send the SoftI2CMaster PCA9685 transmissions in the background by the TWI interrupt.
+ * - Added `ENABLE_PCA9685_SYNCHRONOUS_COMMIT` to latch the new values of all PCA9685 boards of a frame at one stop condition.
+ * - Added `ENABLE_UPDATE_PRIORITY_ORDER` and function `setUpdatePriority()` to update and write critical servos first in each frame.
+ * - Added `ENABLE_LIGHTWEIGHT_SERVO_SUBFRAME_INTERPOLATION` for interpolated LightweightServo periods shorter than the refresh interval.
+ * - Added `ENABLE_TIME_SCALE` and function `setTimeScalePercent()` for a global motion time with slow motion and graceful slowdown of late frames.
+ * - Added `ENABLE_FRAME_WATCHDOG` to stop all servos if the easing interrupt misses its deadline repeatedly.
+ * - Added `USE_FIXED_POINT_MOVE_SETUP` for one integer move setup of the int and float versions of `startEaseTo()` and `startEaseToD()`.
+ * - Added `ENABLE_BATCHED_MOVE_SETUP` for a synchronized move of all servos or a group from one target array in one critical section.
+ * - Added `ENABLE_SIMD_PACKED_UPDATE_KERNEL` for Q15 computation of the packed update kernel with packed 16 bit DSP instructions on Cortex-M4/M7/M33.
+ * - Added `ENABLE_EXTERNAL_FRAME_BUFFER` for a double buffered frame of microseconds or units written by the application and committed at once.
+ * - Added `ENABLE_ESP8266_HARDWARE_TIMER` to time the servo frames of an ESP8266 by the hardware timer1 interrupt instead of the Ticker.
+ *
  * Version 3.1.0 - 08/2022
  * - SAMD51 support by Lutz Aumller.
  * - Added support to pause and resume and `DISABLE_PAUSE_RESUME`.
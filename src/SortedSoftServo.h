@@ -0,0 +1,78 @@
+/*
+ * SortedSoftServo.h
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _SORTED_SOFT_SERVO_H
+#define _SORTED_SOFT_SERVO_H
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) \
+    || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+
+#define VERSION_SORTED_SOFT_SERVO "1.0.0"
+#define VERSION_SORTED_SOFT_SERVO_MAJOR 1
+#define VERSION_SORTED_SOFT_SERVO_MINOR 0
+
+#include <stdint.h>
+
+/*
+ * Software generated servo pulses for any digital pin, using timer1 in CTC mode with TOP determined by ICR1.
+ * All pins are set high together at TOP. Then the pulse widths of all channels are sorted and the pins are set low
+ * by the compare A interrupt in the order of their pulse width.
+ * Pins on the same port with (nearly) the same pulse width are set low by one port write,
+ * so 16 servos require at most 17 and typically only a few interrupts per period.
+ * New values are taken at TOP, so a pulse is never split.
+ * Timer1 compare B is still free, it is used by ServoEasing for its update interrupt.
+ */
+#if !defined(SORTED_SOFT_SERVO_MAX_CHANNELS)
+#define SORTED_SOFT_SERVO_MAX_CHANNELS      16
+#endif
+#if !defined(SORTED_SOFT_SERVO_MAX_PORTS)
+#define SORTED_SOFT_SERVO_MAX_PORTS         4 // Number of different ports the servo pins may be connected to
+#endif
+#if !defined(SORTED_SOFT_SERVO_REFRESH_INTERVAL_MICROS)
+#define SORTED_SOFT_SERVO_REFRESH_INTERVAL_MICROS   20000
+#endif
+#define SORTED_SOFT_SERVO_TICKS_PER_MICROSECOND     (F_CPU / 8000000L) // Timer1 runs with prescaler 8
+/*
+ * Pulses whose end differs less or equal to this value are ended together.
+ * 2 ticks = 1 us at 16 MHz, which is the resolution of writeMicroseconds().
+ */
+#if !defined(SORTED_SOFT_SERVO_MERGE_TICKS)
+#define SORTED_SOFT_SERVO_MERGE_TICKS       2
+#endif
+/*
+ * If the next pulse end is nearer than this value, we wait for it in the interrupt instead of returning
+ * and entering the interrupt again, which would take longer and increase the jitter.
+ */
+#if !defined(SORTED_SOFT_SERVO_MIN_INTERRUPT_TICKS)
+#define SORTED_SOFT_SERVO_MIN_INTERRUPT_TICKS   (12 * SORTED_SOFT_SERVO_TICKS_PER_MICROSECOND)
+#endif
+
+void initSortedSoftServoTimer(); // Sets CTC mode with period of SORTED_SOFT_SERVO_REFRESH_INTERVAL_MICROS, if not already done
+bool initSortedSoftServoPin(uint8_t aPin); // Returns false if all channels or all ports are in use
+void deinitSortedSoftServoPin(uint8_t aPin);
+void writeMicrosecondsSortedSoftServoPin(int aMicroseconds, uint8_t aPin); // 0 disables the pulses of this pin
+uint8_t getSortedSoftServoNumberOfInterruptsInLastPeriod();
+
+#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) ...
+
+#endif // _SORTED_SOFT_SERVO_H
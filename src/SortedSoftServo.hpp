@@ -0,0 +1,274 @@
+/*
+ *  SortedSoftServo.hpp
+ *
+ *  Servo pulses for up to 16 arbitrary pins using timer1 interrupts.
+ *  The pins are set high at the start of the period and set low in the order of their sorted pulse widths.
+ *  The pulse widths are sorted only once per period, and all pins of one port which end at the same time are
+ *  written with one port access. The Arduino Servo library in contrast requires 2 interrupts per servo.
+ *
+ *  Copyright (C) 2022  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
+ *
+ *  ServoEasing is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _SORTED_SOFT_SERVO_HPP
+#define _SORTED_SOFT_SERVO_HPP
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) \
+    || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+#include "SortedSoftServo.h"
+
+#define SORTED_SOFT_SERVO_UNUSED_PIN    0xFF
+
+/*
+ * One entry for each group of pulses ending at the same time.
+ * Ticks are absolute timer values.
+ */
+struct SortedSoftServoEvent {
+    uint16_t Ticks;
+    uint8_t PortMasks[SORTED_SOFT_SERVO_MAX_PORTS];
+};
+
+uint8_t sSortedSoftServoPins[SORTED_SOFT_SERVO_MAX_CHANNELS]; // SORTED_SOFT_SERVO_UNUSED_PIN marks a free channel
+uint8_t sSortedSoftServoPortIndexes[SORTED_SOFT_SERVO_MAX_CHANNELS];
+uint8_t sSortedSoftServoBitMasks[SORTED_SOFT_SERVO_MAX_CHANNELS];
+volatile uint16_t sSortedSoftServoPulseTicks[SORTED_SOFT_SERVO_MAX_CHANNELS]; // 0 -> no pulse
+uint8_t sSortedSoftServoNumberOfChannels; // Index of highest used channel + 1
+
+volatile uint8_t *sSortedSoftServoPortRegisters[SORTED_SOFT_SERVO_MAX_PORTS];
+uint8_t sSortedSoftServoNumberOfPorts;
+volatile uint8_t sSortedSoftServoPortHighMasks[SORTED_SOFT_SERVO_MAX_PORTS]; // Pins with a pulse width != 0
+
+/*
+ * The schedule is rebuilt at TOP and only read by the compare A interrupt until the next TOP
+ */
+uint8_t sSortedSoftServoOrder[SORTED_SOFT_SERVO_MAX_CHANNELS]; // Channel indexes sorted by pulse width, kept from last period
+uint16_t sSortedSoftServoPeriodTicks[SORTED_SOFT_SERVO_MAX_CHANNELS]; // The pulse widths sampled at TOP
+SortedSoftServoEvent sSortedSoftServoEvents[SORTED_SOFT_SERVO_MAX_CHANNELS];
+uint8_t sSortedSoftServoNumberOfEvents;
+uint8_t sSortedSoftServoNextEventIndex;
+uint8_t sSortedSoftServoNumberOfInterrupts;
+uint8_t sSortedSoftServoNumberOfInterruptsInLastPeriod;
+
+/*
+ * Set CTC mode with TOP determined by ICR1 and prescaler 8, if not already done.
+ * The ICNC1 bit used as flag by ServoEasing is kept.
+ */
+void initSortedSoftServoTimer() {
+    if ((TCCR1B & ~_BV(ICNC1)) != (_BV(WGM13) | _BV(WGM12) | _BV(CS11))) {
+        TCCR1A = 0; // no output compare pins
+        TCCR1B = _BV(WGM13) | _BV(WGM12) | _BV(CS11);
+        ICR1 = (SORTED_SOFT_SERVO_REFRESH_INTERVAL_MICROS * SORTED_SOFT_SERVO_TICKS_PER_MICROSECOND) - 1;
+        TIFR1 = _BV(ICF1);
+        TIMSK1 |= _BV(ICIE1); // enable interrupt at TOP
+    }
+}
+
+/*
+ * @return Index in sSortedSoftServoPins or SORTED_SOFT_SERVO_MAX_CHANNELS if pin is not attached
+ */
+uint_fast8_t getSortedSoftServoChannelIndex(uint8_t aPin) {
+    uint_fast8_t tIndex = 0;
+    for (; tIndex < sSortedSoftServoNumberOfChannels; ++tIndex) {
+        if (sSortedSoftServoPins[tIndex] == aPin) {
+            return tIndex;
+        }
+    }
+    return SORTED_SOFT_SERVO_MAX_CHANNELS;
+}
+
+bool initSortedSoftServoPin(uint8_t aPin) {
+    if (getSortedSoftServoChannelIndex(aPin) < SORTED_SOFT_SERVO_MAX_CHANNELS) {
+        return true; // already attached
+    }
+    volatile uint8_t *tPortRegister = portOutputRegister(digitalPinToPort(aPin));
+    uint_fast8_t tPortIndex = 0;
+    for (; tPortIndex < sSortedSoftServoNumberOfPorts; ++tPortIndex) {
+        if (sSortedSoftServoPortRegisters[tPortIndex] == tPortRegister) {
+            break;
+        }
+    }
+    if (tPortIndex >= SORTED_SOFT_SERVO_MAX_PORTS) {
+        return false; // increase SORTED_SOFT_SERVO_MAX_PORTS
+    }
+
+    // Take the first free channel
+    uint_fast8_t tChannelIndex = 0;
+    for (; tChannelIndex < sSortedSoftServoNumberOfChannels; ++tChannelIndex) {
+        if (sSortedSoftServoPins[tChannelIndex] == SORTED_SOFT_SERVO_UNUSED_PIN) {
+            break;
+        }
+    }
+    if (tChannelIndex >= SORTED_SOFT_SERVO_MAX_CHANNELS) {
+        return false;
+    }
+
+    initSortedSoftServoTimer();
+    uint8_t tSREG = SREG;
+    cli(); // channel and port tables are read by the interrupts
+    if (tPortIndex == sSortedSoftServoNumberOfPorts) {
+        sSortedSoftServoPortRegisters[tPortIndex] = tPortRegister;
+        sSortedSoftServoNumberOfPorts++;
+    }
+    sSortedSoftServoPins[tChannelIndex] = aPin;
+    sSortedSoftServoPortIndexes[tChannelIndex] = tPortIndex;
+    sSortedSoftServoBitMasks[tChannelIndex] = digitalPinToBitMask(aPin);
+    sSortedSoftServoPulseTicks[tChannelIndex] = 0; // no pulse until first write
+    if (tChannelIndex == sSortedSoftServoNumberOfChannels) {
+        sSortedSoftServoOrder[tChannelIndex] = tChannelIndex;
+        sSortedSoftServoNumberOfChannels++;
+    }
+    SREG = tSREG;
+    digitalWrite(aPin, LOW);
+    pinMode(aPin, OUTPUT);
+    return true;
+}
+
+/*
+ * Stops the pulses and changes the pin to input. The channel is free for the next init.
+ */
+void deinitSortedSoftServoPin(uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getSortedSoftServoChannelIndex(aPin);
+    if (tChannelIndex < SORTED_SOFT_SERVO_MAX_CHANNELS) {
+        writeMicrosecondsSortedSoftServoPin(0, aPin);
+        sSortedSoftServoPins[tChannelIndex] = SORTED_SOFT_SERVO_UNUSED_PIN;
+        digitalWrite(aPin, LOW); // end a running pulse
+        pinMode(aPin, INPUT);
+    }
+}
+
+/*
+ * The new value is taken at the start of the next period
+ * @param aMicroseconds 0 disables the pulses
+ */
+void writeMicrosecondsSortedSoftServoPin(int aMicroseconds, uint8_t aPin) {
+    uint_fast8_t tChannelIndex = getSortedSoftServoChannelIndex(aPin);
+    if (tChannelIndex < SORTED_SOFT_SERVO_MAX_CHANNELS) {
+        uint_fast8_t tPortIndex = sSortedSoftServoPortIndexes[tChannelIndex];
+        uint8_t tSREG = SREG;
+        cli(); // 16 bit value is read by the TOP interrupt
+        sSortedSoftServoPulseTicks[tChannelIndex] = aMicroseconds * SORTED_SOFT_SERVO_TICKS_PER_MICROSECOND;
+        if (aMicroseconds > 0) {
+            sSortedSoftServoPortHighMasks[tPortIndex] |= sSortedSoftServoBitMasks[tChannelIndex];
+        } else {
+            sSortedSoftServoPortHighMasks[tPortIndex] &= ~sSortedSoftServoBitMasks[tChannelIndex];
+        }
+        SREG = tSREG;
+    }
+}
+
+/*
+ * @return Number of timer interrupts required for generating the pulses in the last period, including the one at TOP
+ */
+uint8_t getSortedSoftServoNumberOfInterruptsInLastPeriod() {
+    return sSortedSoftServoNumberOfInterruptsInLastPeriod;
+}
+
+/*
+ * Set all pins low, whose pulse ends now. Pulse ends, which are too near for a new interrupt, are waited for.
+ * Otherwise the compare A interrupt is set up for the next pulse end.
+ */
+void handleSortedSoftServoEvents() {
+    while (sSortedSoftServoNextEventIndex < sSortedSoftServoNumberOfEvents) {
+        SortedSoftServoEvent *tEvent = &sSortedSoftServoEvents[sSortedSoftServoNextEventIndex];
+        uint16_t tTicks = tEvent->Ticks;
+        if ((int16_t) (tTicks - TCNT1) > SORTED_SOFT_SERVO_MIN_INTERRUPT_TICKS) {
+            OCR1A = tTicks;
+            TIFR1 = _BV(OCF1A); // clear flag of a match of the last period
+            TIMSK1 |= _BV(OCIE1A);
+            return;
+        }
+        while ((int16_t) (tTicks - TCNT1) > 0) {
+            ; // wait for exact end of pulse
+        }
+        for (uint_fast8_t tPortIndex = 0; tPortIndex < SORTED_SOFT_SERVO_MAX_PORTS; ++tPortIndex) {
+            uint8_t tMask = tEvent->PortMasks[tPortIndex];
+            if (tMask != 0) {
+                *sSortedSoftServoPortRegisters[tPortIndex] &= ~tMask;
+            }
+        }
+        sSortedSoftServoNextEventIndex++;
+    }
+    TIMSK1 &= ~_BV(OCIE1A); // all pulses of this period are done
+}
+
+/*
+ * Start of period. Set all pins high, then sort the pulse widths and build the schedule for this period.
+ */
+ISR(TIMER1_CAPT_vect) {
+    for (uint_fast8_t tPortIndex = 0; tPortIndex < sSortedSoftServoNumberOfPorts; ++tPortIndex) {
+        *sSortedSoftServoPortRegisters[tPortIndex] |= sSortedSoftServoPortHighMasks[tPortIndex];
+    }
+    uint16_t tStartTicks = TCNT1; // compensates for the interrupt latency
+    sSortedSoftServoNumberOfInterruptsInLastPeriod = sSortedSoftServoNumberOfInterrupts;
+    sSortedSoftServoNumberOfInterrupts = 1;
+
+    uint_fast8_t tNumberOfChannels = sSortedSoftServoNumberOfChannels;
+    for (uint_fast8_t tChannelIndex = 0; tChannelIndex < tNumberOfChannels; ++tChannelIndex) {
+        sSortedSoftServoPeriodTicks[tChannelIndex] = sSortedSoftServoPulseTicks[tChannelIndex];
+    }
+
+    /*
+     * Insertion sort of the order of the last period. Since the widths change only slightly from period to period,
+     * this requires mostly only one compare per channel.
+     */
+    for (uint_fast8_t i = 1; i < tNumberOfChannels; ++i) {
+        uint8_t tChannelIndex = sSortedSoftServoOrder[i];
+        uint16_t tTicks = sSortedSoftServoPeriodTicks[tChannelIndex];
+        uint_fast8_t j = i;
+        while (j > 0 && sSortedSoftServoPeriodTicks[sSortedSoftServoOrder[j - 1]] > tTicks) {
+            sSortedSoftServoOrder[j] = sSortedSoftServoOrder[j - 1];
+            j--;
+        }
+        sSortedSoftServoOrder[j] = tChannelIndex;
+    }
+
+    /*
+     * Build one event for all pulses ending within SORTED_SOFT_SERVO_MERGE_TICKS
+     */
+    uint_fast8_t tNumberOfEvents = 0;
+    SortedSoftServoEvent *tEvent = &sSortedSoftServoEvents[0];
+    uint16_t tEventTicks = 0;
+    for (uint_fast8_t i = 0; i < tNumberOfChannels; ++i) {
+        uint8_t tChannelIndex = sSortedSoftServoOrder[i];
+        uint16_t tTicks = sSortedSoftServoPeriodTicks[tChannelIndex];
+        if (tTicks == 0 || sSortedSoftServoPins[tChannelIndex] == SORTED_SOFT_SERVO_UNUSED_PIN) {
+            continue; // no pulse
+        }
+        if (tNumberOfEvents == 0 || tTicks - tEventTicks > SORTED_SOFT_SERVO_MERGE_TICKS) {
+            tEvent = &sSortedSoftServoEvents[tNumberOfEvents++];
+            tEventTicks = tTicks;
+            tEvent->Ticks = tStartTicks + tTicks;
+            for (uint_fast8_t tPortIndex = 0; tPortIndex < SORTED_SOFT_SERVO_MAX_PORTS; ++tPortIndex) {
+                tEvent->PortMasks[tPortIndex] = 0;
+            }
+        }
+        tEvent->PortMasks[sSortedSoftServoPortIndexes[tChannelIndex]] |= sSortedSoftServoBitMasks[tChannelIndex];
+    }
+    sSortedSoftServoNumberOfEvents = tNumberOfEvents;
+    sSortedSoftServoNextEventIndex = 0;
+    handleSortedSoftServoEvents();
+}
+
+ISR(TIMER1_COMPA_vect) {
+    sSortedSoftServoNumberOfInterrupts++;
+    handleSortedSoftServoEvents();
+}
+
+#endif // defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__) ...
+#endif // _SORTED_SOFT_SERVO_HPP